@@ -0,0 +1,128 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <fmt/core.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Minimal benchmark harness shared by bench/*.cc
+//   - measure() calibrates a repetition count so one batch lasts at least
+//     min_batch_time, then times several batches and keeps the best and the median
+//   - report() prints every record as JSON (default) or CSV (--format=csv), so runs
+//     can be stored and compared across releases
+
+// keep a value alive so the compiler cannot drop the computation producing it
+template <typename U>
+inline void do_not_optimise(const U &value) {
+  asm volatile("" : : "m"(value) : "memory");
+}
+
+// one measured case
+struct BenchRecord {
+  std::string suite;       // benchmark binary, e.g. "dual"
+  std::string name;        // case, e.g. "mul"
+  std::size_t n;           // problem size (dimension), 1 if not applicable
+  std::size_t repetitions; // calls of the measured function per batch
+  double best_ns;          // fastest batch, ns per call
+  double median_ns;        // median batch, ns per call
+  std::size_t work;        // case-specific count per call (e.g. iterations), or 0
+};
+
+class Bench {
+private:
+  std::string m_suite;
+  std::vector<BenchRecord> m_records;
+  std::chrono::nanoseconds m_min_batch_time{std::chrono::milliseconds(20)};
+  std::size_t m_batches{7};
+  bool m_csv{false};
+
+  template <typename Func>
+  double time_batch(Func &fn, std::size_t repetitions) {
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t r = 0; r < repetitions; r++)
+      fn();
+    const auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count();
+  }
+
+public:
+  // --format=json|csv selects the output of report(), and --quick shortens every
+  // batch, e.g. to smoke-test the suite. Any other argument exits before measuring
+  Bench(std::string suite, int argc, char **argv) : m_suite(std::move(suite)) {
+    for (int i = 1; i < argc; i++) {
+      const std::string_view arg(argv[i]);
+      if (arg == "--format=csv")
+        m_csv = true;
+      else if (arg == "--format=json")
+        m_csv = false;
+      else if (arg == "--quick") {
+        m_min_batch_time = std::chrono::milliseconds(1);
+        m_batches = 3;
+      } else {
+        fmt::print(stderr, "usage: {} [--format=json|csv] [--quick]\n", argv[0]);
+        std::exit(1);
+      }
+    }
+  }
+
+  // time fn(), a call of which is one operation of the case
+  template <typename Func>
+  void measure(std::string name, std::size_t n, Func fn, std::size_t work = 0) {
+    // calibrate: double the repetitions until a batch is long enough
+    std::size_t repetitions{1};
+    while (time_batch(fn, repetitions) < double(m_min_batch_time.count()))
+      repetitions *= 2;
+
+    std::vector<double> per_call(m_batches);
+    for (double &t : per_call)
+      t = time_batch(fn, repetitions) / double(repetitions);
+    std::sort(per_call.begin(), per_call.end());
+
+    m_records.push_back({m_suite,
+                         std::move(name),
+                         n,
+                         repetitions,
+                         per_call.front(),
+                         per_call[per_call.size() / 2],
+                         work});
+  }
+
+  // print the records in the format selected by --format=json|csv
+  int report() const {
+    if (m_csv) {
+      fmt::print("suite,name,n,repetitions,best_ns,median_ns,work\n");
+      for (const BenchRecord &r : m_records)
+        fmt::print("{},{},{},{},{:.3f},{:.3f},{}\n",
+                   r.suite,
+                   r.name,
+                   r.n,
+                   r.repetitions,
+                   r.best_ns,
+                   r.median_ns,
+                   r.work);
+      return 0;
+    }
+
+    fmt::print("[\n");
+    for (std::size_t i = 0; i < m_records.size(); i++) {
+      const BenchRecord &r = m_records[i];
+      fmt::print("  {{\"suite\": \"{}\", \"name\": \"{}\", \"n\": {}, "
+                 "\"repetitions\": {}, \"best_ns\": {:.3f}, \"median_ns\": {:.3f}, "
+                 "\"work\": {}}}{}\n",
+                 r.suite,
+                 r.name,
+                 r.n,
+                 r.repetitions,
+                 r.best_ns,
+                 r.median_ns,
+                 r.work,
+                 i + 1 < m_records.size() ? "," : "");
+    }
+    fmt::print("]\n");
+    return 0;
+  }
+};
@@ -0,0 +1,40 @@
+// Benchmark: throughput of single Dual<double> operations, next to plain double
+#include "bench.h"
+#include <cmath>
+#include <gradual/dual.h>
+
+// time op(x, y) for one scalar type; x and y are reloaded from memory at every call,
+// so the result cannot be folded or hoisted out of the loop
+template <typename U, typename Op>
+void measure_op(Bench &bench, const std::string &name, U x, U y, Op op) {
+  bench.measure(name, 1, [&] {
+    do_not_optimise(x);
+    do_not_optimise(y);
+    const U result = op(x, y);
+    do_not_optimise(result);
+  });
+}
+
+template <typename U>
+void measure_ops(Bench &bench, const std::string &prefix, U x, U y) {
+  measure_op(bench, prefix + "add", x, y, [](U a, U b) { return a + b; });
+  measure_op(bench, prefix + "mul", x, y, [](U a, U b) { return a * b; });
+  measure_op(bench, prefix + "div", x, y, [](U a, U b) { return a / b; });
+  measure_op(bench, prefix + "exp", x, y, [](U a, U) { return exp(a); });
+  measure_op(bench, prefix + "log", x, y, [](U a, U) { return log(a); });
+  measure_op(bench, prefix + "sqrt", x, y, [](U a, U) { return sqrt(a); });
+  measure_op(bench, prefix + "pow_int", x, y, [](U a, U) { return pow(a, 3); });
+  measure_op(bench, prefix + "pow_real", x, y, [](U a, U) { return pow(a, 2.5); });
+  measure_op(bench, prefix + "sin", x, y, [](U a, U) { return sin(a); });
+  measure_op(bench, prefix + "cos", x, y, [](U a, U) { return cos(a); });
+  measure_op(bench, prefix + "sin_cos", x, y, [](U a, U) { return sin(a) * cos(a); });
+}
+
+int main(int argc, char **argv) {
+  using std::cos, std::exp, std::log, std::pow, std::sin, std::sqrt;
+
+  Bench bench("dual", argc, argv);
+  measure_ops(bench, "double_", 1.3, 0.7);
+  measure_ops(bench, "dual_", Dual<double>(1.3, 1.0), Dual<double>(0.7, 0.0));
+  return bench.report();
+}
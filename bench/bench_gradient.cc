@@ -0,0 +1,162 @@
+// Benchmark: cost of one gradient versus the number of parameters N, per backend,
+// of a dense versus a compressed sparse Hessian, and versus the number of samples of
+// a least-squares objective
+#include "bench.h"
+#include <array>
+#include <gradual/gradient.h>
+#include <gradual/reverse.h>
+#include <gradual/sparsity.h>
+#include <gradual/sum_over.h>
+#include <utility>
+#include <vector>
+
+// separable sum plus a coupling term, so every partial depends on all parameters
+struct Model {
+  template <typename... X>
+  auto operator()(X... x) const {
+    const auto squares = ((x * x) + ...);
+    const auto coupling = ((sin(x) * 0.5) + ...);
+    return squares + coupling * coupling;
+  }
+};
+
+// same model over a span, for the runtime-size overloads
+struct SpanModel {
+  template <typename Span>
+  auto operator()(Span x) const {
+    auto squares = x[0] * x[0], coupling = sin(x[0]) * 0.5;
+    for (std::size_t i = 1; i < x.size(); i++) {
+      squares = squares + x[i] * x[i];
+      coupling = coupling + sin(x[i]) * 0.5;
+    }
+    return squares + coupling * coupling;
+  }
+};
+
+template <std::size_t N>
+void measure_fixed(Bench &bench) {
+  using std::sin;
+  Vector<double, N> point{};
+  for (std::size_t i = 0; i < N; i++)
+    point[i] = 0.1 * double(i + 1);
+
+  bench.measure("forward", N, [&] {
+    do_not_optimise(point);
+    do_not_optimise(gradient(Model{}, point));
+  });
+  bench.measure("lanes_8", N, [&] {
+    do_not_optimise(point);
+    do_not_optimise(gradient<8>(Model{}, point));
+  });
+  bench.measure("masked", N, [&] {
+    do_not_optimise(point);
+    do_not_optimise(masked_gradient(Model{}, point));
+  });
+  ReverseGradient reverse;
+  bench.measure("reverse", N, [&] {
+    do_not_optimise(point);
+    do_not_optimise(reverse(Model{}, point));
+  });
+}
+
+void measure_dynamic(Bench &bench, std::size_t n) {
+  DynamicVector<double> point(n);
+  for (std::size_t i = 0; i < n; i++)
+    point[i] = 0.1 * double(i + 1);
+
+  bench.measure("dynamic_forward", n, [&] {
+    do_not_optimise(point);
+    do_not_optimise(gradient(SpanModel{}, point));
+  });
+  bench.measure("dynamic_lanes_8", n, [&] {
+    do_not_optimise(point);
+    do_not_optimise(gradient<8>(SpanModel{}, point));
+  });
+  ReverseGradient reverse;
+  bench.measure("dynamic_reverse", n, [&] {
+    do_not_optimise(point);
+    do_not_optimise(reverse(SpanModel{}, point));
+  });
+}
+
+// each parameter coupled to its neighbours only, so the Hessian is tridiagonal
+struct ChainModel {
+  template <typename X, typename... Xs>
+  auto operator()(X x0, Xs... xs) const {
+    const std::array<X, sizeof...(Xs) + 1> x{x0, xs...};
+    auto sum = x[0] * x[0];
+    for (std::size_t i = 0; i + 1 < x.size(); i++) {
+      const auto d = x[i + 1] - x[i];
+      sum = sum + d * d * (x[i + 1] + 2.0) + sin(x[i]);
+    }
+    return sum;
+  }
+};
+
+// dense Hessian, N(N+1)/2 hyper-dual passes, versus 3 compressed passes
+template <std::size_t N>
+void measure_hessian(Bench &bench) {
+  Vector<double, N> point{};
+  for (std::size_t i = 0; i < N; i++)
+    point[i] = 0.1 * double(i + 1);
+  const SparseSeeds seeds = sparse_hessian_seeds(ChainModel{}, point);
+
+  bench.measure("hessian_dense", N, [&] {
+    do_not_optimise(point);
+    do_not_optimise(hessian(ChainModel{}, point));
+  });
+  bench.measure("hessian_sparse", N, [&] {
+    do_not_optimise(point);
+    do_not_optimise(hessian(ChainModel{}, point, seeds));
+  });
+}
+
+// quadratic fit over n samples, summed in the objective versus with sum_over
+void measure_dataset(Bench &bench, std::size_t n) {
+  std::vector<double> data_x(n), data_y(n);
+  for (std::size_t i = 0; i < n; i++) {
+    data_x[i] = -2.0 + 4.0 * double(i) / double(n);
+    data_y[i] = 0.5 * data_x[i] * data_x[i] + data_x[i] + 2.0;
+  }
+  auto squared_residual = [&](std::size_t i, auto a, auto b, auto c) {
+    auto residual = a * data_x[i] * data_x[i] + b * data_x[i] + c - data_y[i];
+    return residual * residual;
+  };
+  auto loop = [&](auto a, auto b, auto c) {
+    auto sum = a * 0.0;
+    for (std::size_t i = 0; i < n; i++)
+      sum = sum + squared_residual(i, a, b, c);
+    return sum;
+  };
+  auto objective = sum_over(n, squared_residual);
+  const Vector point{0.1, 0.5, 1.0};
+
+  bench.measure("dataset_loop", n, [&] {
+    do_not_optimise(point);
+    do_not_optimise(gradient(loop, point));
+  });
+  bench.measure("dataset_sum_over", n, [&] {
+    do_not_optimise(point);
+    do_not_optimise(gradient(objective, point));
+  });
+}
+
+int main(int argc, char **argv) {
+  Bench bench("gradient", argc, argv);
+
+  [&]<std::size_t... Sizes>(std::index_sequence<Sizes...>) {
+    (measure_fixed<Sizes>(bench), ...);
+  }(std::index_sequence<1, 2, 4, 8, 16, 32>{});
+
+  for (std::size_t n : std::array<std::size_t, 4>{16, 64, 256, 1024})
+    measure_dynamic(bench, n);
+
+  [&]<std::size_t... Sizes>(std::index_sequence<Sizes...>) {
+    (measure_hessian<Sizes>(bench), ...);
+  }(std::index_sequence<4, 8, 16, 32>{});
+
+  for (std::size_t n : std::array<std::size_t, 3>{10000, 100000, 1000000})
+    measure_dataset(bench, n);
+
+  return bench.report();
+}
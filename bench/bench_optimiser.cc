@@ -0,0 +1,122 @@
+// Benchmark: complete minimise() runs on the Rosenbrock and quadratic_fit problems
+// work reports the iterations of each run, so a change in speed can be told apart
+// from a change in the path taken by the optimiser
+#include "bench.h"
+#include <array>
+#include <gradual/lbfgs.h>
+#include <gradual/least_squares.h>
+#include <gradual/line_search.h>
+#include <gradual/newton.h>
+#include <gradual/optimiser.h>
+#include <gradual/reverse.h>
+#include <random>
+
+// time opt.minimise(f, start), once per call
+template <typename Opt, typename Func, std::size_t N>
+void measure_minimise(Bench &bench,
+                      const std::string &name,
+                      Opt opt,
+                      Func f,
+                      const Vector<double, N> &start) {
+  const std::size_t iterations = opt.minimise(f, start).num_iterations();
+  bench.measure(
+      name,
+      N,
+      [&] {
+        do_not_optimise(start);
+        do_not_optimise(opt.minimise(f, start));
+      },
+      iterations);
+}
+
+int main(int argc, char **argv) {
+  Bench bench("optimiser", argc, argv);
+
+  // Rosenbrock from the classic start (-1.2, 1), minimum at (1, 1)
+  auto rosenbrock = [](auto x, auto y) {
+    return pow(1 - x, 2) + 100 * pow(y - x * x, 2);
+  };
+  const Vector rosenbrock_start{-1.2, 1.0};
+
+  measure_minimise(bench,
+                   "rosenbrock_fixed_step",
+                   Optimiser(1.e-3, 1.e-6, 100000),
+                   rosenbrock,
+                   rosenbrock_start);
+  measure_minimise(bench,
+                   "rosenbrock_armijo",
+                   Optimiser(1.0, 1.e-6, 100000, Armijo<double>{}),
+                   rosenbrock,
+                   rosenbrock_start);
+  measure_minimise(bench,
+                   "rosenbrock_strong_wolfe",
+                   Optimiser(1.0, 1.e-6, 100000, StrongWolfe<double>{}),
+                   rosenbrock,
+                   rosenbrock_start);
+  measure_minimise(bench,
+                   "rosenbrock_reverse",
+                   Optimiser<double, ReverseGradient>(1.e-3, 1.e-6, 100000),
+                   rosenbrock,
+                   rosenbrock_start);
+  measure_minimise(bench,
+                   "rosenbrock_lbfgs",
+                   LbfgsOptimiser<double>(1.e-6),
+                   rosenbrock,
+                   rosenbrock_start);
+  measure_minimise(
+      bench, "rosenbrock_newton", NewtonOptimiser(1.e-6), rosenbrock, rosenbrock_start);
+  auto rosenbrock_residuals = [](auto x, auto y) {
+    return Vector{1 - x, 10 * (y - x * x)};
+  };
+  measure_minimise(bench,
+                   "rosenbrock_levenberg_marquardt",
+                   LeastSquaresOptimiser<double>(1.e-6),
+                   rosenbrock_residuals,
+                   rosenbrock_start);
+
+  // quadratic_fit example: y = 0.5 x^2 + x + 2 plus noise, on 8 random points
+  constexpr int n_points = 8;
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<> x_dist(-2.0, 2.0);
+  std::uniform_real_distribution<> noise_dist(-0.2, 0.2);
+  std::array<double, n_points> data_x, data_y;
+  for (int i = 0; i < n_points; ++i) {
+    data_x[i] = x_dist(gen);
+    data_y[i] = 0.5 * data_x[i] * data_x[i] + data_x[i] + 2.0 + noise_dist(gen);
+  }
+
+  auto cost = [&](auto a, auto b, auto c) {
+    decltype(a) sum = a * 0.0;
+    for (int i = 0; i < n_points; ++i) {
+      auto residual = a * data_x[i] * data_x[i] + b * data_x[i] + c - data_y[i];
+      sum = sum + residual * residual;
+    }
+    return sum;
+  };
+  const Vector fit_start{0.1, 0.5, 1.0};
+
+  measure_minimise(
+      bench, "quadratic_fit_fixed_step", Optimiser(0.01, 1.e-6), cost, fit_start);
+  measure_minimise(bench,
+                   "quadratic_fit_strong_wolfe",
+                   Optimiser(1.0, 1.e-6, 10000, StrongWolfe<double>{}),
+                   cost,
+                   fit_start);
+  measure_minimise(
+      bench, "quadratic_fit_lbfgs", LbfgsOptimiser<double>(1.e-6), cost, fit_start);
+  measure_minimise(
+      bench, "quadratic_fit_newton", NewtonOptimiser(1.e-6), cost, fit_start);
+  auto residuals = [&](auto a, auto b, auto c) {
+    Vector<decltype(a), n_points> r;
+    for (int i = 0; i < n_points; ++i)
+      r[i] = a * data_x[i] * data_x[i] + b * data_x[i] + c - data_y[i];
+    return r;
+  };
+  measure_minimise(bench,
+                   "quadratic_fit_levenberg_marquardt",
+                   LeastSquaresOptimiser<double>(1.e-6),
+                   residuals,
+                   fit_start);
+
+  return bench.report();
+}
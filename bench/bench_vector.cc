@@ -0,0 +1,58 @@
+// Benchmark: element loops of Vector, axpy and dot product, for a fixed and a
+// runtime size. The build also compiles this file with GRADUAL_BOUNDS_CHECK into
+// bench_vector_checked, whose suite is "vector_checked", so the cost of the checks in
+// operator[] can be read off by comparing the two
+#include "bench.h"
+#include <cstddef>
+#include <gradual/vector.h>
+
+#ifdef GRADUAL_BOUNDS_CHECK
+constexpr const char *suite = "vector_checked";
+#else
+constexpr const char *suite = "vector";
+#endif
+
+// y += a x and x . y; the vectors are reloaded from memory at every call, so the
+// loops cannot be hoisted out of the batch
+template <typename V>
+void measure_kernels(Bench &bench, const std::string &prefix, V x, V y) {
+  const std::size_t n = x.size();
+  bench.measure(prefix + "axpy", n, [&] {
+    do_not_optimise(x);
+    y += 1e-3 * x;
+    do_not_optimise(y);
+  });
+  bench.measure(prefix + "dot", n, [&] {
+    do_not_optimise(x);
+    do_not_optimise(y);
+    const double dot = x * y;
+    do_not_optimise(dot);
+  });
+}
+
+template <std::size_t N>
+void measure_fixed(Bench &bench) {
+  Vector<double, N> x{}, y{};
+  for (std::size_t i = 0; i < N; i++) {
+    x[i] = 1.0 + 0.01 * double(i);
+    y[i] = 2.0 - 0.01 * double(i);
+  }
+  measure_kernels(bench, "fixed_", x, y);
+}
+
+void measure_dynamic(Bench &bench, std::size_t n) {
+  DynamicVector<double> x(n), y(n);
+  for (std::size_t i = 0; i < n; i++) {
+    x[i] = 1.0 + 1e-4 * double(i);
+    y[i] = 2.0 - 1e-4 * double(i);
+  }
+  measure_kernels(bench, "dynamic_", x, y);
+}
+
+int main(int argc, char **argv) {
+  Bench bench(suite, argc, argv);
+  measure_fixed<16>(bench);
+  for (std::size_t n : {16, 1024, 65536})
+    measure_dynamic(bench, n);
+  return bench.report();
+}
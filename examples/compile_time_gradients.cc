@@ -29,6 +29,21 @@ int main() {
   fmt::print("\nGradient at point (3, 4):\n");
   fmt::print("  f(x, y) = x^2 + y^2\n");
   fmt::print("  ∇f(3, 4) = ({}, {})\n", grad[0], grad[1]);
+
+  // Compile-time gradient of a model with transcendental terms
+  constexpr auto model = [](auto a, auto b) {
+    return exp(-a * b) * sin(a) + log(b) * sqrt(a);
+  };
+  constexpr Vector<double, 2> at(1.0, 2.0);
+  constexpr auto sensitivity = gradient(model, at);
+  // ∂f/∂a = e^{-ab} (cos a − b sin a) + log(b) / (2 sqrt(a)) ≈ 0.1919
+  // ∂f/∂b = −a e^{-ab} sin a + sqrt(a) / b ≈ 0.3861
+  static_assert(sensitivity[0] > 0.191 and sensitivity[0] < 0.192);
+  static_assert(sensitivity[1] > 0.386 and sensitivity[1] < 0.387);
+
+  fmt::print("\nGradient at point (1, 2):\n");
+  fmt::print("  f(a, b) = exp(-a b) sin(a) + log(b) sqrt(a)\n");
+  fmt::print("  ∇f(1, 2) = ({}, {})\n", sensitivity[0], sensitivity[1]);
   
   fmt::print("\nAll compile-time checks passed.\n");
 
@@ -0,0 +1,38 @@
+// Example: a model with thousands of parameters on a runtime-size vector
+#include <fmt/core.h>
+#include <gradual/optimiser.h>
+#include <gradual/reverse.h>
+
+int main() {
+  // smoothing of a noisy signal: stay close to the data, penalise roughness
+  // f takes a span of active scalars instead of one argument per parameter
+  constexpr std::size_t n = 2000;
+  DynamicVector<double> data(n);
+  for (std::size_t i = 0; i < n; i++)
+    data[i] = std::sin(0.01 * double(i)) + 0.3 * std::sin(7.0 * double(i));
+
+  auto model = [&data](auto x) {
+    auto sum = x[0] * 0.0;
+    for (std::size_t i = 0; i < x.size(); i++)
+      sum = sum + pow(x[i] - data[i], 2);
+    for (std::size_t i = 0; i + 1 < x.size(); i++)
+      sum = sum + 10.0 * pow(x[i + 1] - x[i], 2);
+    return sum;
+  };
+
+  fmt::print("Smoothing a signal of {} samples\n\n", n);
+
+  // reverse mode: the whole gradient from one recording of the model
+  Optimiser<double, ReverseGradient, StrongWolfe<double>> opt(1.0, 1.e-4, 10000);
+  auto res = opt.minimise(model, data);
+
+  fmt::print("  Converged: {}\n", res.converged());
+  fmt::print("  Value at minimum: {:.6f}\n", res.value());
+  fmt::print("  Iterations: {}\n", res.num_iterations());
+  fmt::print("  First samples: {:.4f} {:.4f} {:.4f}\n",
+             res.point()[0],
+             res.point()[1],
+             res.point()[2]);
+
+  return 0;
+}
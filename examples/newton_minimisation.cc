@@ -0,0 +1,30 @@
+// Example: Newton minimisation with exact Hessians on the Rosenbrock function
+#include <fmt/core.h>
+#include <gradual/newton.h>
+
+int main() {
+  // same model and start as custom_model.cc
+  auto rosenbrock = [](auto x, auto y) {
+    return pow(1 - x, 2) + 100 * pow(y - x * x, 2);
+  };
+  Vector init{-1.0, 1.0};
+
+  fmt::print("Minimising Rosenbrock function from (-1, 1):\n");
+  fmt::print("  f(x, y) = (1-x)² + 100(y-x²)²\n\n");
+
+  NewtonOptimiser newton(1.e-8);
+  auto res = newton.minimise(rosenbrock, init);
+  fmt::print("Newton (trust region):\n");
+  fmt::print("  Converged: {}\n", res.converged());
+  fmt::print("  Best point: ({:.6f}, {:.6f})\n", res.point()[0], res.point()[1]);
+  fmt::print("  Iterations: {}\n", res.num_iterations());
+
+  Optimiser descent(0.001, 1.e-6, 100000);
+  auto ref = descent.minimise(rosenbrock, init);
+  fmt::print("Fixed-step gradient descent:\n");
+  fmt::print("  Converged: {}\n", ref.converged());
+  fmt::print("  Best point: ({:.6f}, {:.6f})\n", ref.point()[0], ref.point()[1]);
+  fmt::print("  Iterations: {}\n", ref.num_iterations());
+
+  return 0;
+}
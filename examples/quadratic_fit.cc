@@ -1,5 +1,6 @@
 // Example: Fitting a quadratic function to randomly generated data points
 #include <gradual/optimiser.h>
+#include <gradual/sum_over.h>
 #include <fmt/core.h>
 #include <random>
 #include <array>
@@ -24,15 +25,12 @@ int main() {
     }
     
     // Define cost function (sum of squared residuals)
-    auto cost = [&](auto a, auto b, auto c) {
-        decltype(a) sum = a * 0.0;  // Initialize with correct type
-        for (int i = 0; i < n_points; ++i) {
-            auto predicted = a * data_x[i] * data_x[i] + b * data_x[i] + c;
-            auto residual = predicted - data_y[i];
-            sum = sum + residual * residual;
-        }
-        return sum;
-    };
+    // sum_over adds one term per data point; large datasets are split across threads
+    auto cost = sum_over(n_points, [&](std::size_t i, auto a, auto b, auto c) {
+        auto predicted = a * data_x[i] * data_x[i] + b * data_x[i] + c;
+        auto residual = predicted - data_y[i];
+        return residual * residual;
+    });
     
     // Initial guess (different from true parameters)
     Vector init{0.1, 0.5, 1.0};
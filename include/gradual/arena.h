@@ -0,0 +1,118 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+// Bump allocator backed by a list of large blocks.
+//   - allocate() hands out memory linearly from the current block, and only touches
+//     the heap when no existing block has room left
+//   - rewind() releases everything at once by resetting the offsets; blocks are kept,
+//     so recording the same amount of data again makes no heap allocation
+// Objects placed in the arena must be trivially destructible: nothing is destroyed.
+// Copying an arena copies its configuration only, the copy starts empty.
+class Arena {
+private:
+  struct Block {
+    std::unique_ptr<std::byte[]> data;
+    std::size_t size;
+  };
+
+  std::vector<Block> m_blocks;
+  std::size_t m_block_size{};
+  std::size_t m_current{0}; // index of the block being filled
+  std::size_t m_offset{0};  // first free byte in the current block
+  std::size_t m_bytes{0};   // bytes handed out since the last rewind
+  std::size_t m_peak_bytes{0};
+  std::size_t m_reuse_count{0};
+  std::size_t m_heap_allocations{0};
+
+  static constexpr std::size_t align_up(std::size_t offset, std::size_t alignment) {
+    return (offset + alignment - 1) / alignment * alignment;
+  }
+
+public:
+  static constexpr std::size_t default_block_size = 64 * 1024;
+
+  explicit Arena(std::size_t block_size = default_block_size)
+      : m_block_size(block_size) {
+  }
+  Arena(const Arena &other) : m_block_size(other.m_block_size) {
+  }
+  Arena &operator=(const Arena &other) {
+    if (this != &other)
+      *this = Arena(other.m_block_size);
+    return *this;
+  }
+  Arena(Arena &&) noexcept = default;
+  Arena &operator=(Arena &&) noexcept = default;
+
+  // raw allocation of bytes with the given (power of two) alignment
+  void *allocate(std::size_t bytes, std::size_t alignment) {
+    // move on to the next block (kept from a previous pass, or new) until one fits
+    while (m_current < m_blocks.size()) {
+      const std::size_t start = align_up(m_offset, alignment);
+      if (start + bytes <= m_blocks[m_current].size) {
+        m_bytes += start - m_offset + bytes;
+        m_peak_bytes = std::max(m_peak_bytes, m_bytes);
+        m_offset = start + bytes;
+        return m_blocks[m_current].data.get() + start;
+      }
+      m_current++;
+      m_offset = 0;
+    }
+
+    // blocks are allocated with operator new[], so alignment up to
+    // __STDCPP_DEFAULT_NEW_ALIGNMENT__ holds at the start of every block
+    const std::size_t size = std::max(m_block_size, bytes);
+    m_blocks.push_back({std::make_unique<std::byte[]>(size), size});
+    m_heap_allocations++;
+    m_current = m_blocks.size() - 1;
+    m_offset = bytes;
+    m_bytes += bytes;
+    m_peak_bytes = std::max(m_peak_bytes, m_bytes);
+    return m_blocks[m_current].data.get();
+  }
+
+  // typed allocation of an uninitialised array of n objects
+  template <typename U>
+    requires std::is_trivially_destructible_v<U>
+  U *allocate(std::size_t n) {
+    static_assert(alignof(U) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+    return static_cast<U *>(this->allocate(n * sizeof(U), alignof(U)));
+  }
+
+  // release all allocations, keeping the blocks for the next pass
+  void rewind() {
+    if (m_bytes > 0)
+      m_reuse_count++;
+    m_current = 0;
+    m_offset = 0;
+    m_bytes = 0;
+  }
+
+  // Statistics
+  [[nodiscard]] std::size_t bytes_in_use() const {
+    return m_bytes;
+  }
+  [[nodiscard]] std::size_t peak_bytes() const {
+    return m_peak_bytes;
+  }
+  [[nodiscard]] std::size_t capacity() const {
+    std::size_t total = 0;
+    for (const Block &block : m_blocks)
+      total += block.size;
+    return total;
+  }
+  // number of rewinds after which recorded memory was handed out again
+  [[nodiscard]] std::size_t reuse_count() const {
+    return m_reuse_count;
+  }
+  // number of blocks requested from the heap over the arena lifetime
+  [[nodiscard]] std::size_t heap_allocations() const {
+    return m_heap_allocations;
+  }
+};
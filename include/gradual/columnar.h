@@ -0,0 +1,328 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Columnar dataset files, read through a memory map (POSIX).
+// Layout, in native byte order:
+//   - header: magic "GRDLCOLS", u32 version (1), u32 number of columns,
+//     u64 number of rows
+//   - one descriptor per column: name (32 bytes, NUL-padded), u32 type
+//     (0 = float64, 1 = float32), u32 reserved, u64 byte offset of the data
+//   - the columns, each a contiguous array of rows values starting on a 64-byte
+//     boundary
+// Opening a file reads the header and descriptors only: the data is paged in by the
+// OS when first touched, so startup does not depend on the size of the dataset.
+
+enum class ColumnType : std::uint32_t { float64 = 0, float32 = 1 };
+
+template <typename T>
+constexpr ColumnType column_type_of() {
+  static_assert(std::is_same_v<T, double> or std::is_same_v<T, float>,
+                "columns hold double or float values");
+  return std::is_same_v<T, double> ? ColumnType::float64 : ColumnType::float32;
+}
+
+constexpr std::size_t column_type_size(ColumnType type) {
+  return type == ColumnType::float64 ? sizeof(double) : sizeof(float);
+}
+
+namespace columnar_format {
+inline constexpr char magic[8] = {'G', 'R', 'D', 'L', 'C', 'O', 'L', 'S'};
+inline constexpr std::uint32_t version = 1;
+inline constexpr std::size_t header_size = 24;
+inline constexpr std::size_t name_size = 32;
+inline constexpr std::size_t descriptor_size = 48;
+inline constexpr std::size_t alignment = 64;
+} // namespace columnar_format
+
+// rows [begin, end) of a dataset
+struct RowRange {
+  std::size_t begin{};
+  std::size_t end{};
+
+  std::size_t size() const {
+    return end - begin;
+  }
+};
+
+// Read-only, zero-copy view of a columnar file
+//   - column<T>(name) is a std::span<const T> straight into the mapping, to be
+//     captured by the loss (e.g. in sum_over or StochasticOptimiser::minimise_over)
+//   - chunk(i, chunk_size) splits the rows for batched or parallel loops
+// The spans stay valid as long as the MappedDataset. Malformed files throw
+// std::runtime_error; a missing column or a type mismatch std::invalid_argument.
+class MappedDataset {
+private:
+  struct Column {
+    std::string name;
+    ColumnType type;
+    std::size_t offset;
+  };
+
+  const std::byte *m_data{nullptr};
+  std::size_t m_bytes{0};
+  std::size_t m_rows{0};
+  std::vector<Column> m_columns;
+
+  template <typename U>
+  static U read(const std::byte *at) {
+    U value;
+    std::memcpy(&value, at, sizeof(U));
+    return value;
+  }
+
+  [[noreturn]] static void malformed(const std::string &path, const char *what) {
+    throw std::runtime_error("MappedDataset: " + path + ": " + what);
+  }
+
+  void unmap() {
+    if (m_data != nullptr)
+      ::munmap(const_cast<std::byte *>(m_data), m_bytes);
+    m_data = nullptr;
+  }
+
+public:
+  enum class Access { normal, sequential, random };
+
+  explicit MappedDataset(const std::string &path) {
+    namespace format = columnar_format;
+
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+      throw std::system_error(errno, std::generic_category(), "MappedDataset: " + path);
+    struct stat info {};
+    if (::fstat(fd, &info) != 0) {
+      const int error = errno;
+      ::close(fd);
+      throw std::system_error(error, std::generic_category(), "MappedDataset: " + path);
+    }
+    m_bytes = std::size_t(info.st_size);
+    if (m_bytes < format::header_size) {
+      ::close(fd);
+      malformed(path, "truncated header");
+    }
+
+    void *mapping = ::mmap(nullptr, m_bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    const int error = errno;
+    ::close(fd); // the mapping keeps the file alive
+    if (mapping == MAP_FAILED)
+      throw std::system_error(error, std::generic_category(), "MappedDataset: " + path);
+    m_data = static_cast<const std::byte *>(mapping);
+
+    try {
+      if (std::memcmp(m_data, format::magic, sizeof(format::magic)) != 0)
+        malformed(path, "not a columnar dataset");
+      if (read<std::uint32_t>(m_data + 8) != format::version)
+        malformed(path, "unsupported version");
+      const std::size_t num_columns = read<std::uint32_t>(m_data + 12);
+      m_rows = std::size_t(read<std::uint64_t>(m_data + 16));
+      if (m_bytes < format::header_size + num_columns * format::descriptor_size)
+        malformed(path, "truncated column descriptors");
+
+      m_columns.reserve(num_columns);
+      for (std::size_t c = 0; c < num_columns; c++) {
+        const std::byte *descriptor =
+            m_data + format::header_size + c * format::descriptor_size;
+        const char *name = reinterpret_cast<const char *>(descriptor);
+        const auto type = ColumnType(read<std::uint32_t>(descriptor + 32));
+        const auto offset = std::size_t(read<std::uint64_t>(descriptor + 40));
+        if (type != ColumnType::float64 and type != ColumnType::float32)
+          malformed(path, "unknown column type");
+        if (offset % format::alignment != 0 or offset > m_bytes or
+            (m_bytes - offset) / column_type_size(type) < m_rows)
+          malformed(path, "column data out of the file");
+        m_columns.push_back(
+            {std::string(name, ::strnlen(name, format::name_size)), type, offset});
+      }
+    } catch (...) {
+      unmap();
+      throw;
+    }
+  }
+
+  MappedDataset(const MappedDataset &) = delete;
+  MappedDataset &operator=(const MappedDataset &) = delete;
+
+  MappedDataset(MappedDataset &&other) noexcept
+      : m_data(std::exchange(other.m_data, nullptr)), m_bytes(other.m_bytes),
+        m_rows(other.m_rows), m_columns(std::move(other.m_columns)) {
+  }
+  MappedDataset &operator=(MappedDataset &&other) noexcept {
+    if (this != &other) {
+      unmap();
+      m_data = std::exchange(other.m_data, nullptr);
+      m_bytes = other.m_bytes;
+      m_rows = other.m_rows;
+      m_columns = std::move(other.m_columns);
+    }
+    return *this;
+  }
+
+  ~MappedDataset() {
+    unmap();
+  }
+
+  // number of rows
+  std::size_t size() const {
+    return m_rows;
+  }
+
+  std::size_t num_columns() const {
+    return m_columns.size();
+  }
+  const std::string &column_name(std::size_t index) const {
+    return m_columns.at(index).name;
+  }
+  ColumnType column_type(std::size_t index) const {
+    return m_columns.at(index).type;
+  }
+
+  // index of the column called name, throws std::invalid_argument if there is none
+  std::size_t column_index(std::string_view name) const {
+    for (std::size_t c = 0; c < m_columns.size(); c++)
+      if (m_columns[c].name == name)
+        return c;
+    throw std::invalid_argument("MappedDataset: no column " + std::string(name));
+  }
+
+  // values of a column, T must match its stored type
+  template <typename T>
+  std::span<const T> column(std::size_t index) const {
+    const Column &column = m_columns.at(index);
+    if (column.type != column_type_of<T>())
+      throw std::invalid_argument("MappedDataset: column " + column.name +
+                                  " has another type");
+    return {reinterpret_cast<const T *>(m_data + column.offset), m_rows};
+  }
+
+  template <typename T>
+  std::span<const T> column(std::string_view name) const {
+    return column<T>(column_index(name));
+  }
+
+  // rows of a column within range
+  template <typename T>
+  std::span<const T> column(std::string_view name, RowRange range) const {
+    return column<T>(name).subspan(range.begin, range.size());
+  }
+
+  // number of chunks of chunk_size rows, the last one possibly shorter
+  std::size_t num_chunks(std::size_t chunk_size) const {
+    chunk_size = std::max<std::size_t>(chunk_size, 1);
+    return (m_rows + chunk_size - 1) / chunk_size;
+  }
+
+  RowRange chunk(std::size_t index, std::size_t chunk_size) const {
+    chunk_size = std::max<std::size_t>(chunk_size, 1);
+    const std::size_t begin = std::min(index * chunk_size, m_rows);
+    return {begin, std::min(begin + chunk_size, m_rows)};
+  }
+
+  // hint the expected access pattern to the OS, e.g. random for shuffled mini-batches
+  void advise(Access access) const {
+    const int advice = access == Access::sequential ? MADV_SEQUENTIAL
+                       : access == Access::random   ? MADV_RANDOM
+                                                    : MADV_NORMAL;
+    ::madvise(const_cast<std::byte *>(m_data), m_bytes, advice);
+  }
+};
+
+// Writes columnar files for MappedDataset
+// add_column() only keeps a view of the values, which must live until write()
+class ColumnarWriter {
+private:
+  struct Column {
+    std::string name;
+    ColumnType type;
+    const void *data;
+  };
+
+  std::vector<Column> m_columns;
+  std::size_t m_rows{0};
+
+  template <typename T>
+  ColumnarWriter &add(std::string_view name, std::span<const T> values) {
+    if (name.empty() or name.size() > columnar_format::name_size)
+      throw std::invalid_argument("ColumnarWriter: column names have 1 to 32 chars");
+    if (not m_columns.empty() and values.size() != m_rows)
+      throw std::invalid_argument("ColumnarWriter: columns differ in length");
+    m_rows = values.size();
+    m_columns.push_back({std::string(name), column_type_of<T>(), values.data()});
+    return *this;
+  }
+
+public:
+  ColumnarWriter &add_column(std::string_view name, std::span<const double> values) {
+    return add(name, values);
+  }
+  ColumnarWriter &add_column(std::string_view name, std::span<const float> values) {
+    return add(name, values);
+  }
+
+  void write(const std::string &path) const {
+    namespace format = columnar_format;
+    auto align = [](std::size_t offset) {
+      return (offset + format::alignment - 1) / format::alignment * format::alignment;
+    };
+
+    // header and descriptors
+    std::vector<std::byte> head(format::header_size +
+                                m_columns.size() * format::descriptor_size);
+    auto put = [&](std::size_t at, auto value) {
+      std::memcpy(head.data() + at, &value, sizeof(value));
+    };
+    std::memcpy(head.data(), format::magic, sizeof(format::magic));
+    put(8, format::version);
+    put(12, std::uint32_t(m_columns.size()));
+    put(16, std::uint64_t(m_rows));
+
+    std::vector<std::size_t> offsets;
+    std::size_t offset = align(head.size());
+    for (std::size_t c = 0; c < m_columns.size(); c++) {
+      const std::size_t at = format::header_size + c * format::descriptor_size;
+      std::memcpy(head.data() + at, m_columns[c].name.data(), m_columns[c].name.size());
+      put(at + 32, std::uint32_t(m_columns[c].type));
+      put(at + 40, std::uint64_t(offset));
+      offsets.push_back(offset);
+      offset = align(offset + m_rows * column_type_size(m_columns[c].type));
+    }
+
+    std::unique_ptr<std::FILE, int (*)(std::FILE *)> file(
+        std::fopen(path.c_str(), "wb"), &std::fclose);
+    if (not file)
+      throw std::system_error(
+          errno, std::generic_category(), "ColumnarWriter: " + path);
+
+    bool ok = std::fwrite(head.data(), 1, head.size(), file.get()) == head.size();
+    std::size_t written = head.size();
+    const std::byte padding[format::alignment]{};
+    for (std::size_t c = 0; c < m_columns.size() and ok; c++) {
+      ok = std::fwrite(padding, 1, offsets[c] - written, file.get()) ==
+           offsets[c] - written;
+      const std::size_t bytes = m_rows * column_type_size(m_columns[c].type);
+      ok = ok and std::fwrite(m_columns[c].data, 1, bytes, file.get()) == bytes;
+      written = offsets[c] + bytes;
+    }
+    if (not ok or std::fflush(file.get()) != 0)
+      throw std::runtime_error("ColumnarWriter: " + path + ": write failed");
+  }
+};
@@ -0,0 +1,325 @@
+#pragma once
+
+#include <cmath>
+#include <concepts>
+#include <limits>
+#include <type_traits>
+
+// Elementary functions usable in constant expressions: sqrt, exp, log, sin, cos, tan,
+// pow and abs. At run time they call <cmath>; <cmath> is not constexpr (yet), so
+// during constant evaluation they use the portable versions in constexpr_math::detail:
+//   - sqrt: Newton iterations on the mantissa, scaled into [1/2, 2)
+//   - exp: exp(r) 2^k with |r| <= ln(2)/2, Taylor series for exp(r)
+//   - log: k ln(2) + 2 atanh((m - 1)/(m + 1)) with m in [1/√2, √2)
+//   - sin, cos: reduction to |r| <= π/4 by multiples of π/2, Taylor series
+//   - pow: binary powering for integer exponents, exp(n log(a)) otherwise
+// The portable versions compute in long double and are within a few ulp of <cmath> for
+// double arguments; sin, cos and tan lose precision beyond |x| ~ 1e9.
+namespace constexpr_math {
+namespace detail {
+
+using wide = long double;
+
+inline constexpr wide infinity = std::numeric_limits<wide>::infinity();
+inline constexpr wide nan = std::numeric_limits<wide>::quiet_NaN();
+
+// ln(2) and π/2 split in two, the high parts with enough trailing zero bits that
+// k * high is exact for the k used in the reductions
+inline constexpr wide ln2_hi = 6.93147180369123816490e-01L;
+inline constexpr wide ln2_lo = 1.90821492927058770002e-10L;
+inline constexpr wide pio2_hi = 1.57079632673412561417e+00L;
+inline constexpr wide pio2_lo = 6.07710050650619224932e-11L;
+
+// largest |x| for which exp(x) and 1/exp(x) are finite
+inline constexpr wide log_max =
+    wide(std::numeric_limits<wide>::max_exponent - 2) * (ln2_hi + ln2_lo);
+
+constexpr bool isnan(wide x) {
+  return x != x;
+}
+
+// nearest integer, halfway cases away from zero
+constexpr long long round(wide x) {
+  return static_cast<long long>(x < 0 ? x - 0.5L : x + 0.5L);
+}
+
+// x 2^k, without overflowing the intermediate powers of two
+constexpr wide scale(wide x, long long k) {
+  wide base = k < 0 ? 0.5L : 2.0L;
+  for (unsigned long long n = k < 0 ? -k : k; n > 0; n >>= 1) {
+    if (n & 1)
+      x *= base;
+    if (n > 1)
+      base *= base;
+  }
+  return x;
+}
+
+// x = m 2^k with m in [1/√2, √2), for finite x > 0
+struct Split {
+  wide mantissa;
+  long long exponent;
+};
+
+constexpr Split split(wide x) {
+  constexpr wide sqrt2 = 1.41421356237309504880L;
+  long long k = 0;
+  while (x >= 0x1p64L) {
+    x *= 0x1p-64L;
+    k += 64;
+  }
+  while (x < 0x1p-64L) {
+    x *= 0x1p64L;
+    k -= 64;
+  }
+  while (x >= sqrt2) {
+    x *= 0.5L;
+    k++;
+  }
+  while (x < sqrt2 / 2) {
+    x *= 2;
+    k--;
+  }
+  return {x, k};
+}
+
+constexpr wide sqrt(wide x) {
+  if (isnan(x) or x < 0)
+    return nan;
+  if (x == 0 or x == infinity)
+    return x;
+  // x = m 4^k, m in [1/2, 2), so the root of m is in [0.7, 1.42)
+  auto [m, k] = split(x);
+  if (k % 2 != 0) {
+    m *= 2;
+    k--;
+  }
+  wide y = (1 + m) / 2;
+  for (int i = 0; i < 6; i++)
+    y = (y + m / y) / 2;
+  return scale(y, k / 2);
+}
+
+constexpr wide exp(wide x) {
+  if (isnan(x))
+    return x;
+  if (x > log_max)
+    return infinity;
+  if (x < -2 * log_max)
+    return 0;
+  const long long k = round(x / (ln2_hi + ln2_lo));
+  const wide r = (x - wide(k) * ln2_hi) - wide(k) * ln2_lo;
+  wide sum = 1, term = 1;
+  for (int n = 1; n < 40; n++) {
+    term *= r / n;
+    if (sum + term == sum)
+      break;
+    sum += term;
+  }
+  return scale(sum, k);
+}
+
+constexpr wide log(wide x) {
+  if (isnan(x) or x < 0)
+    return nan;
+  if (x == 0)
+    return -infinity;
+  if (x == infinity)
+    return x;
+  const auto [m, k] = split(x);
+  // log(m) = 2 atanh(s) = 2 (s + s³/3 + s⁵/5 + ...), |s| <= 0.172
+  const wide s = (m - 1) / (m + 1), s2 = s * s;
+  wide sum = s, power = s;
+  for (int n = 3; n < 60; n += 2) {
+    power *= s2;
+    const wide term = power / n;
+    if (sum + term == sum)
+      break;
+    sum += term;
+  }
+  return wide(k) * ln2_hi + (wide(k) * ln2_lo + 2 * sum);
+}
+
+// sin(r) and cos(r) for |r| <= π/4
+constexpr wide sin_series(wide r) {
+  const wide r2 = r * r;
+  wide sum = r, term = r;
+  for (int n = 2; n < 40; n += 2) {
+    term *= -r2 / (n * (n + 1));
+    if (sum + term == sum)
+      break;
+    sum += term;
+  }
+  return sum;
+}
+
+constexpr wide cos_series(wide r) {
+  const wide r2 = r * r;
+  wide sum = 1, term = 1;
+  for (int n = 1; n < 40; n += 2) {
+    term *= -r2 / (n * (n + 1));
+    if (sum + term == sum)
+      break;
+    sum += term;
+  }
+  return sum;
+}
+
+// x = r + q π/2 with |r| <= π/4, q taken modulo 4
+struct Reduced {
+  wide r;
+  int quadrant;
+};
+
+constexpr Reduced reduce(wide x) {
+  const long long k = round(x / (pio2_hi + pio2_lo));
+  return {(x - wide(k) * pio2_hi) - wide(k) * pio2_lo, int(((k % 4) + 4) % 4)};
+}
+
+constexpr wide sin(wide x) {
+  if (isnan(x) or x == infinity or x == -infinity)
+    return nan;
+  const auto [r, quadrant] = reduce(x);
+  switch (quadrant) {
+  case 0:
+    return sin_series(r);
+  case 1:
+    return cos_series(r);
+  case 2:
+    return -sin_series(r);
+  default:
+    return -cos_series(r);
+  }
+}
+
+constexpr wide cos(wide x) {
+  if (isnan(x) or x == infinity or x == -infinity)
+    return nan;
+  const auto [r, quadrant] = reduce(x);
+  switch (quadrant) {
+  case 0:
+    return cos_series(r);
+  case 1:
+    return -sin_series(r);
+  case 2:
+    return -cos_series(r);
+  default:
+    return sin_series(r);
+  }
+}
+
+constexpr wide tan(wide x) {
+  if (isnan(x) or x == infinity or x == -infinity)
+    return nan;
+  const auto [r, quadrant] = reduce(x);
+  const wide s = sin_series(r), c = cos_series(r);
+  return quadrant % 2 == 0 ? s / c : -c / s;
+}
+
+constexpr wide pow(wide a, wide n) {
+  if (n == 0 or a == 1)
+    return 1;
+  if (isnan(a) or isnan(n))
+    return nan;
+  // integers beyond 2^63 are even
+  const bool huge = n >= 0x1p63L or n <= -0x1p63L;
+  const bool integer = huge or wide(static_cast<long long>(n)) == n;
+  const bool odd = integer and not huge and static_cast<long long>(n) % 2 != 0;
+  if (a < 0 and not integer)
+    return nan;
+  const wide sign = a < 0 and odd ? -1 : 1;
+  const wide magnitude = a < 0 ? -a : a;
+  if (magnitude == 0)
+    return n > 0 ? sign * 0 : sign * infinity;
+  if (magnitude == infinity)
+    return n > 0 ? sign * infinity : sign * 0;
+
+  // out of range results, and non-integer exponents
+  const wide exponent = n * log(magnitude);
+  if (exponent > log_max)
+    return sign * infinity;
+  if (exponent < -2 * log_max)
+    return sign * 0;
+  if (not integer or huge or exponent < -log_max)
+    return sign * exp(exponent);
+
+  // binary powering, exact for small integer results
+  const long long k = static_cast<long long>(n);
+  wide result = 1, base = magnitude;
+  for (unsigned long long m = k < 0 ? -k : k; m > 0; m >>= 1) {
+    if (m & 1)
+      result *= base;
+    if (m > 1)
+      base *= base;
+  }
+  return sign * (k < 0 ? 1 / result : result);
+}
+
+// wide to T, saturating to ±infinity out of the range of T
+template <std::floating_point T>
+constexpr T narrow(wide x) {
+  if (x > std::numeric_limits<T>::max())
+    return std::numeric_limits<T>::infinity();
+  if (x < std::numeric_limits<T>::lowest())
+    return -std::numeric_limits<T>::infinity();
+  return T(x);
+}
+
+} // namespace detail
+
+// |x|, std::abs is only constexpr from C++23
+template <std::floating_point T>
+constexpr T abs(T x) {
+  return x < T(0) ? -x : x;
+}
+
+template <std::floating_point T>
+constexpr T sqrt(T x) {
+  if (std::is_constant_evaluated())
+    return detail::narrow<T>(detail::sqrt(x));
+  return std::sqrt(x);
+}
+
+template <std::floating_point T>
+constexpr T exp(T x) {
+  if (std::is_constant_evaluated())
+    return detail::narrow<T>(detail::exp(x));
+  return std::exp(x);
+}
+
+template <std::floating_point T>
+constexpr T log(T x) {
+  if (std::is_constant_evaluated())
+    return detail::narrow<T>(detail::log(x));
+  return std::log(x);
+}
+
+template <std::floating_point T>
+constexpr T sin(T x) {
+  if (std::is_constant_evaluated())
+    return detail::narrow<T>(detail::sin(x));
+  return std::sin(x);
+}
+
+template <std::floating_point T>
+constexpr T cos(T x) {
+  if (std::is_constant_evaluated())
+    return detail::narrow<T>(detail::cos(x));
+  return std::cos(x);
+}
+
+template <std::floating_point T>
+constexpr T tan(T x) {
+  if (std::is_constant_evaluated())
+    return detail::narrow<T>(detail::tan(x));
+  return std::tan(x);
+}
+
+template <std::floating_point T>
+constexpr T pow(T a, T n) {
+  if (std::is_constant_evaluated())
+    return detail::narrow<T>(detail::pow(a, n));
+  return std::pow(a, n);
+}
+
+} // namespace constexpr_math
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <cmath>
+#include "constexpr_math.h"
 #include <concepts>
 
 // Dual numbers represent values of the form a + b ε where ε^2 = 0.
@@ -125,65 +125,66 @@ constexpr Dual<T> operator/(I scalar, const Dual<T> &dual) {
 // Elementary operations
 // These functions follow standard derivative rules and operate on Dual<T> where
 // T is floating-point
-// Note that std::cmath does not support (yet) constexpr functions
+// They are constexpr: constant evaluation goes through constexpr_math (see
+// constexpr_math.h), so models with transcendental terms differentiate at compile time
 
 // sqrt(a + b ε) = sqrt(a) + (b / (2 sqrt(a))) ε
 template <typename T>
   requires std::floating_point<T>
-Dual<T> sqrt(const Dual<T> &x) {
-  const T r = std::sqrt(x.real());
+constexpr Dual<T> sqrt(const Dual<T> &x) {
+  const T r = constexpr_math::sqrt(x.real());
   return {r, x.dual() / (T(2) * r)};
 }
 
 // (a + b ε)^n = a^n + b·n·a^{n-1} ε
 template <typename T>
   requires std::floating_point<T>
-Dual<T> pow(const Dual<T> &x, const T &n) {
+constexpr Dual<T> pow(const Dual<T> &x, const T &n) {
   const T a = x.real();
-  const T r = std::pow(a, n);
-  return {r, x.dual() * n * std::pow(a, n - T(1))};
+  const T r = constexpr_math::pow(a, n);
+  return {r, x.dual() * n * constexpr_math::pow(a, n - T(1))};
 }
 
 // Overload for integer exponents (allows pow(x, 2) instead of pow(x, 2.0))
 template <typename T, std::integral I>
   requires std::floating_point<T>
-Dual<T> pow(const Dual<T> &x, I n) {
+constexpr Dual<T> pow(const Dual<T> &x, I n) {
   return pow(x, T(n));
 }
 
 // exp(a + b ε) = exp(a) + b·exp(a) ε
 template <typename T>
   requires std::floating_point<T>
-Dual<T> exp(const Dual<T> &x) {
-  const T r = std::exp(x.real());
+constexpr Dual<T> exp(const Dual<T> &x) {
+  const T r = constexpr_math::exp(x.real());
   return {r, r * x.dual()};
 }
 
 // log(a + b ε) = log(a) + (b / a) ε
 template <typename T>
   requires std::floating_point<T>
-Dual<T> log(const Dual<T> &x) {
-  return {std::log(x.real()), x.dual() / x.real()};
+constexpr Dual<T> log(const Dual<T> &x) {
+  return {constexpr_math::log(x.real()), x.dual() / x.real()};
 }
 
 // sin(a + b ε) = sin(a) + b·cos(a) ε
 template <typename T>
   requires std::floating_point<T>
-Dual<T> sin(const Dual<T> &x) {
-  return {std::sin(x.real()), x.dual() * std::cos(x.real())};
+constexpr Dual<T> sin(const Dual<T> &x) {
+  return {constexpr_math::sin(x.real()), x.dual() * constexpr_math::cos(x.real())};
 }
 
 // cos(a + b ε) = cos(a) − b·sin(a) ε
 template <typename T>
   requires std::floating_point<T>
-Dual<T> cos(const Dual<T> &x) {
-  return {std::cos(x.real()), -x.dual() * std::sin(x.real())};
+constexpr Dual<T> cos(const Dual<T> &x) {
+  return {constexpr_math::cos(x.real()), -x.dual() * constexpr_math::sin(x.real())};
 }
 
 // tan(a + b ε) = tan(a) + b·(1 + tan(a)^2) ε
 template <typename T>
   requires std::floating_point<T>
-Dual<T> tan(const Dual<T> &x) {
-  const T r = std::tan(x.real());
+constexpr Dual<T> tan(const Dual<T> &x) {
+  const T r = constexpr_math::tan(x.real());
   return {r, x.dual() * (T(1) + r * r)};
 }
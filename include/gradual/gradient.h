@@ -1,9 +1,19 @@
 #pragma once
 
 #include "dual.h"
+#include "hyper_dual.h"
+#include "masked_dual.h"
+#include "matrix.h"
+#include "multi_dual.h"
 #include "vector.h"
+#include <algorithm>
+#include <array>
 #include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 // construct the dual basis AT COMPILE TIME
 //   - this function intended to get the vectors (1, ..., 0) , (0, 1, ..., 0),
@@ -21,34 +31,386 @@ constexpr Vector<Dual<T>, N> make_dual_basis(const Vector<T, N> &point) {
 }
 
 // evaluate function with dual basis at dimension Dim
-// this yields the gradient projected at dimension Dim
+// this yields f (real part) and the gradient projected at dimension Dim (dual part)
 // i.e., ∂f/∂x_Dim
 template <typename T, std::size_t N, std::size_t Dim, typename Func>
-constexpr T get_partial_derivative(Func f, const Vector<T, N> &point) {
+constexpr Dual<T> get_partial_derivative(Func f, const Vector<T, N> &point) {
   auto duals = make_dual_basis<T, N, Dim>(point);
 
   // unpack duals into function call
   // evaluate f(vec(a) + vec(b) eps) = f(vec(a)) + grad_f * vec(b) eps
   // since vec(b) is non-zero only for index Dim, the dual part gives ∂f/∂x_Dim
-  Dual<T> result = [&]<std::size_t... Indices>(std::index_sequence<Indices...>) {
+  return [&]<std::size_t... Indices>(std::index_sequence<Indices...>) {
     return f(duals[Indices]...);
   }(std::make_index_sequence<N>{});
-
-  return result.dual();
 }
 
+// function value and gradient at a point
+template <typename T, std::size_t N>
+struct FirstOrder {
+  T value;
+  Vector<T, N> gradient;
+};
+
 // get all gradients using index_sequence
+// every pass also carries f in its real part, so the value comes for free
 template <typename T, std::size_t N, typename Func, std::size_t... Dims>
-constexpr Vector<T, N>
-get_gradient_impl(Func f, const Vector<T, N> &point, std::index_sequence<Dims...>) {
-  Vector<T, N> grad;
+constexpr FirstOrder<T, N> get_value_and_gradient_impl(Func f,
+                                                       const Vector<T, N> &point,
+                                                       std::index_sequence<Dims...>) {
+  FirstOrder<T, N> result{};
   // fill gradients
-  (..., (grad[Dims] = get_partial_derivative<T, N, Dims, Func>(f, point)));
+  (..., [&] {
+    const Dual<T> partial = get_partial_derivative<T, N, Dims, Func>(f, point);
+    result.value = partial.real();
+    result.gradient[Dims] = partial.dual();
+  }());
+
+  return result;
+}
 
-  return grad;
+// f and ∇f at point, from the same N evaluations of f
+template <typename T, std::size_t N, typename Func>
+constexpr FirstOrder<T, N> value_and_gradient(Func f, const Vector<T, N> &point) {
+  return get_value_and_gradient_impl(f, point, std::make_index_sequence<N>{});
 }
 
 template <typename T, std::size_t N, typename Func>
 constexpr Vector<T, N> gradient(Func f, const Vector<T, N> &point) {
-  return get_gradient_impl(f, point, std::make_index_sequence<N>{});
+  return value_and_gradient(f, point).gradient;
+}
+
+// f and ∇f for a runtime-size point
+//   - f takes a std::span<const Dual<T>> of the active scalars instead of N arguments
+//   - the seeds live in one heap vector; pass i re-seeds coordinate i only
+template <typename T, typename Func>
+FirstOrder<T, std::dynamic_extent> value_and_gradient(Func f,
+                                                      const DynamicVector<T> &point) {
+  const std::size_t n = point.size();
+  FirstOrder<T, std::dynamic_extent> result{T(0), DynamicVector<T>(n)};
+  DynamicVector<Dual<T>> duals(n);
+  for (std::size_t j = 0; j < n; j++)
+    duals[j] = Dual<T>(point[j], T(0));
+
+  for (std::size_t i = 0; i < n; i++) {
+    duals[i] = Dual<T>(point[i], T(1));
+    const Dual<T> partial = f(duals.values());
+    duals[i] = Dual<T>(point[i], T(0));
+    result.value = partial.real();
+    result.gradient[i] = partial.dual();
+  }
+
+  return result;
+}
+
+template <typename T, typename Func>
+DynamicVector<T> gradient(Func f, const DynamicVector<T> &point) {
+  return value_and_gradient(f, point).gradient;
+}
+
+// one flag per coordinate of a Vector<T, N>, e.g. the variables held on a bound
+template <std::size_t N>
+using CoordinateMask = std::conditional_t<N == std::dynamic_extent,
+                                          std::vector<bool>,
+                                          std::array<bool, N>>;
+
+// f and the partial derivatives along the coordinates that are not frozen
+//   - frozen coordinates are never seeded: one Dual<T> pass per free coordinate
+//   - their gradient entries are 0
+//   - with every coordinate frozen, a single pass still returns f
+template <typename T, std::size_t N, typename Func>
+constexpr FirstOrder<T, N> value_and_gradient(Func f,
+                                              const Vector<T, N> &point,
+                                              const CoordinateMask<N> &frozen) {
+  const std::size_t n = point.size();
+  FirstOrder<T, N> result{T(0), point};
+  Vector<Dual<T>, N> duals{};
+  if constexpr (N == std::dynamic_extent)
+    duals = Vector<Dual<T>, N>(n);
+  for (std::size_t j = 0; j < n; j++) {
+    duals[j] = Dual<T>(point[j], T(0));
+    result.gradient[j] = T(0);
+  }
+
+  bool evaluated{false};
+  for (std::size_t i = 0; i < n; i++) {
+    if (frozen[i])
+      continue;
+    duals[i] = Dual<T>(point[i], T(1));
+    const Dual<T> partial = invoke_unpacked(f, duals);
+    duals[i] = Dual<T>(point[i], T(0));
+    result.value = partial.real();
+    result.gradient[i] = partial.dual();
+    evaluated = true;
+  }
+  if (not evaluated)
+    result.value = invoke_unpacked(f, duals).real();
+
+  return result;
+}
+
+// residuals r(x) ∈ ℝ^M and their M×N Jacobian at a point
+template <typename T, std::size_t M, std::size_t N>
+struct ResidualsAndJacobian {
+  Vector<T, M> residuals;
+  Matrix<T, M, N> jacobian; // jacobian(i, j) = ∂r_i/∂x_j
+};
+
+// r and its Jacobian for a vector-valued f returning Vector<Dual<T>, M>
+// pass j seeds x_j, so column j of the Jacobian is the dual part of the M outputs;
+// N evaluations of f, each also giving r in its real parts
+template <typename T, std::size_t N, typename Func>
+constexpr auto value_and_jacobian(Func f, const Vector<T, N> &point) {
+  using Outputs = decltype(invoke_unpacked(f, std::declval<Vector<Dual<T>, N> &>()));
+  constexpr std::size_t M = Outputs::extent;
+  ResidualsAndJacobian<T, M, N> result{};
+
+  Vector<Dual<T>, N> duals{};
+  for (std::size_t j = 0; j < N; j++)
+    duals[j] = Dual<T>(point[j], T(0));
+
+  for (std::size_t j = 0; j < N; j++) {
+    duals[j] = Dual<T>(point[j], T(1));
+    const Outputs outputs = invoke_unpacked(f, duals);
+    duals[j] = Dual<T>(point[j], T(0));
+    for (std::size_t i = 0; i < M; i++) {
+      result.residuals[i] = outputs[i].real();
+      result.jacobian(i, j) = outputs[i].dual();
+    }
+  }
+
+  return result;
+}
+
+// M×N Jacobian of a vector-valued f at point, N evaluations of f
+template <typename T, std::size_t N, typename Func>
+constexpr auto jacobian(Func f, const Vector<T, N> &point) {
+  return value_and_jacobian(f, point).jacobian;
+}
+
+// construct a K-lane dual basis
+//   - lane k of element j is seeded with 1 if j == offset + k, 0 otherwise
+//   - one evaluation with this basis yields ∂f/∂x_offset, ..., ∂f/∂x_{offset+K-1}
+template <typename T, std::size_t N, std::size_t K>
+constexpr Vector<MultiDual<T, K>, N> make_multi_dual_basis(const Vector<T, N> &point,
+                                                           std::size_t offset) {
+  Vector<MultiDual<T, K>, N> result{};
+
+  for (std::size_t j = 0; j < N; j++) {
+    std::array<T, K> lanes{};
+    if (j >= offset and j - offset < K)
+      lanes[j - offset] = T(1);
+    result[j] = MultiDual<T, K>(point[j], lanes);
+  }
+
+  return result;
+}
+
+// evaluate function with the K-lane dual basis starting at dimension offset
+// lane k of the result holds ∂f/∂x_{offset+k}
+template <typename T, std::size_t N, std::size_t K, typename Func>
+constexpr MultiDual<T, K> get_partial_derivatives(Func f,
+                                                  const Vector<T, N> &point,
+                                                  std::size_t offset) {
+  auto duals = make_multi_dual_basis<T, N, K>(point, offset);
+
+  return [&]<std::size_t... Indices>(std::index_sequence<Indices...>) {
+    return f(duals[Indices]...);
+  }(std::make_index_sequence<N>{});
+}
+
+// f and ∇f using K tangent lanes per evaluation
+// f is evaluated ceil(N / K) times instead of N times; K >= N does it in one pass
+template <std::size_t K, typename T, std::size_t N, typename Func>
+  requires(K > 0)
+constexpr FirstOrder<T, N> value_and_gradient(Func f, const Vector<T, N> &point) {
+  FirstOrder<T, N> result{};
+
+  for (std::size_t offset = 0; offset < N; offset += K) {
+    const auto partials = get_partial_derivatives<T, N, K, Func>(f, point, offset);
+    result.value = partials.real();
+    for (std::size_t k = 0; k < K and offset + k < N; k++)
+      result.gradient[offset + k] = partials.dual(k);
+  }
+
+  return result;
+}
+
+// get all gradients using K tangent lanes per evaluation
+template <std::size_t K, typename T, std::size_t N, typename Func>
+  requires(K > 0)
+constexpr Vector<T, N> gradient(Func f, const Vector<T, N> &point) {
+  return value_and_gradient<K>(f, point).gradient;
+}
+
+// f and ∇f for a runtime-size point, K tangent lanes per evaluation
+// f takes a std::span<const MultiDual<T, K>>; ceil(n / K) evaluations
+template <std::size_t K, typename T, typename Func>
+  requires(K > 0)
+FirstOrder<T, std::dynamic_extent> value_and_gradient(Func f,
+                                                      const DynamicVector<T> &point) {
+  const std::size_t n = point.size();
+  FirstOrder<T, std::dynamic_extent> result{T(0), DynamicVector<T>(n)};
+  DynamicVector<MultiDual<T, K>> duals(n);
+  for (std::size_t j = 0; j < n; j++)
+    duals[j] = MultiDual<T, K>(point[j], std::array<T, K>{});
+
+  for (std::size_t offset = 0; offset < n; offset += K) {
+    const std::size_t end = std::min(offset + K, n);
+    for (std::size_t j = offset; j < end; j++) {
+      std::array<T, K> lanes{};
+      lanes[j - offset] = T(1);
+      duals[j] = MultiDual<T, K>(point[j], lanes);
+    }
+
+    const MultiDual<T, K> partials = f(duals.values());
+    result.value = partials.real();
+    for (std::size_t j = offset; j < end; j++) {
+      result.gradient[j] = partials.dual(j - offset);
+      duals[j] = MultiDual<T, K>(point[j], std::array<T, K>{});
+    }
+  }
+
+  return result;
 }
+
+template <std::size_t K, typename T, typename Func>
+  requires(K > 0)
+DynamicVector<T> gradient(Func f, const DynamicVector<T> &point) {
+  return value_and_gradient<K>(f, point).gradient;
+}
+
+// f and ∇f from a single evaluation on MaskedDual<T, 1 << i> arguments
+// every operation only updates the tangents of the inputs it depends on, so separable
+// terms cost no work on the lanes of the other parameters
+// f must let each argument keep its own type, e.g. a generic lambda
+template <typename T, std::size_t N, typename Func>
+  requires(N <= 64)
+constexpr FirstOrder<T, N> masked_value_and_gradient(Func f,
+                                                     const Vector<T, N> &point) {
+  const auto partials = [&]<std::size_t... Indices>(std::index_sequence<Indices...>) {
+    return f(MaskedDual<T, std::uint64_t(1) << Indices>::variable(point[Indices])...);
+  }(std::make_index_sequence<N>{});
+
+  FirstOrder<T, N> result{};
+  result.value = partials.real();
+  for (std::size_t i = 0; i < N; i++)
+    result.gradient[i] = partials.dual(i);
+  return result;
+}
+
+template <typename T, std::size_t N, typename Func>
+  requires(N <= 64)
+constexpr Vector<T, N> masked_gradient(Func f, const Vector<T, N> &point) {
+  return masked_value_and_gradient(f, point).gradient;
+}
+
+// evaluate function with hyper-dual seeds e_i (ε1) and e_j (ε2)
+// the result holds f (real part), ∂f/∂x_i (ε1), ∂f/∂x_j (ε2) and ∂²f/∂x_i∂x_j (ε1ε2)
+template <typename T, std::size_t N, typename Func>
+constexpr HyperDual<T> get_second_partial_derivative(Func f,
+                                                     const Vector<T, N> &point,
+                                                     std::size_t i,
+                                                     std::size_t j) {
+  std::array<HyperDual<T>, N> hyper_duals{};
+  for (std::size_t k = 0; k < N; k++)
+    hyper_duals[k] =
+        HyperDual<T>(point[k], k == i ? T(1) : T(0), k == j ? T(1) : T(0), T(0));
+
+  return [&]<std::size_t... Indices>(std::index_sequence<Indices...>) {
+    return f(hyper_duals[Indices]...);
+  }(std::make_index_sequence<N>{});
+}
+
+// function value, gradient and Hessian at a point
+template <typename T, std::size_t N>
+struct SecondOrder {
+  T value;
+  Vector<T, N> gradient;
+  Matrix<T, N, N> hessian;
+};
+
+// f, ∇f and the exact N×N Hessian of f at point
+// the Hessian is symmetric, so only the N(N+1)/2 entries with i <= j are evaluated;
+// the diagonal passes also give f and ∇f for free
+// f must accept HyperDual<T> arguments, e.g. a generic lambda
+template <typename T, std::size_t N, typename Func>
+constexpr SecondOrder<T, N> value_gradient_hessian(Func f, const Vector<T, N> &point) {
+  SecondOrder<T, N> result{};
+
+  for (std::size_t i = 0; i < N; i++) {
+    for (std::size_t j = i; j < N; j++) {
+      const HyperDual<T> h = get_second_partial_derivative(f, point, i, j);
+      result.hessian(i, j) = h.eps12();
+      result.hessian(j, i) = h.eps12();
+      if (i == j) {
+        result.value = h.real();
+        result.gradient[i] = h.eps1();
+      }
+    }
+  }
+
+  return result;
+}
+
+// exact N×N Hessian of f at point, N(N+1)/2 evaluations of f
+template <typename T, std::size_t N, typename Func>
+constexpr Matrix<T, N, N> hessian(Func f, const Vector<T, N> &point) {
+  return value_gradient_hessian(f, point).hessian;
+}
+
+// Gradient backends, used by Optimiser to select how gradients are computed
+// operator() returns ∇f; value_and_gradient() also returns f from the same passes
+
+// forward mode, one Dual<T> evaluation of f per dimension
+struct ForwardGradient {
+  template <typename T, std::size_t N, typename Func>
+  constexpr Vector<T, N> operator()(Func f, const Vector<T, N> &point) const {
+    return gradient(f, point);
+  }
+
+  template <typename T, std::size_t N, typename Func>
+  constexpr FirstOrder<T, N>
+  value_and_gradient(Func f, const Vector<T, N> &point) const {
+    return ::value_and_gradient(f, point);
+  }
+
+  // skipping the passes of the frozen coordinates
+  template <typename T, std::size_t N, typename Func>
+  constexpr FirstOrder<T, N> value_and_gradient(Func f,
+                                                const Vector<T, N> &point,
+                                                const CoordinateMask<N> &frozen) const {
+    return ::value_and_gradient(f, point, frozen);
+  }
+};
+
+// forward mode with K tangent lanes, ceil(N / K) evaluations of f per gradient
+// f must accept MultiDual<T, K> arguments, e.g. a generic lambda
+template <std::size_t K = 8>
+struct LaneGradient {
+  template <typename T, std::size_t N, typename Func>
+  constexpr Vector<T, N> operator()(Func f, const Vector<T, N> &point) const {
+    return gradient<K>(f, point);
+  }
+
+  template <typename T, std::size_t N, typename Func>
+  constexpr FirstOrder<T, N>
+  value_and_gradient(Func f, const Vector<T, N> &point) const {
+    return ::value_and_gradient<K>(f, point);
+  }
+};
+
+// forward mode with compile-time dependency masks, one evaluation of f per gradient
+// f must accept MaskedDual<T, Mask> arguments of distinct types, e.g. a generic lambda
+struct MaskedGradient {
+  template <typename T, std::size_t N, typename Func>
+  constexpr Vector<T, N> operator()(Func f, const Vector<T, N> &point) const {
+    return masked_gradient(f, point);
+  }
+
+  template <typename T, std::size_t N, typename Func>
+  constexpr FirstOrder<T, N>
+  value_and_gradient(Func f, const Vector<T, N> &point) const {
+    return masked_value_and_gradient(f, point);
+  }
+};
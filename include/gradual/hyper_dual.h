@@ -0,0 +1,214 @@
+#pragma once
+
+#include "constexpr_math.h"
+#include <concepts>
+
+// Hyper-dual numbers represent values of the form a + b ε1 + c ε2 + d ε1ε2, where
+// ε1^2 = ε2^2 = 0 but ε1ε2 ≠ 0. For an analytic function,
+//   f(x + ε1 u + ε2 v) = f(x) + f'(x)·u ε1 + f'(x)·v ε2 + uᵀ f''(x) v ε1ε2
+// so seeding u = e_i, v = e_j reads the exact second derivative ∂²f/∂x_i∂x_j off the
+// ε1ε2 part, with no truncation or cancellation error.
+// Template parameter T must be a floating-point type.
+template <typename T>
+  requires std::floating_point<T>
+class HyperDual {
+private:
+  T m_real;
+  T m_eps1;
+  T m_eps2;
+  T m_eps12;
+
+public:
+  using value_type = T;
+
+  // Constructor
+  constexpr HyperDual() : m_real(T(0)), m_eps1(T(0)), m_eps2(T(0)), m_eps12(T(0)) {
+  }
+  constexpr HyperDual(T real, T eps1, T eps2, T eps12)
+      : m_real(real), m_eps1(eps1), m_eps2(eps2), m_eps12(eps12) {
+  }
+
+  // Accessors
+  [[nodiscard]] constexpr T real() const {
+    return m_real;
+  }
+  [[nodiscard]] constexpr T eps1() const {
+    return m_eps1;
+  }
+  [[nodiscard]] constexpr T eps2() const {
+    return m_eps2;
+  }
+  [[nodiscard]] constexpr T eps12() const {
+    return m_eps12;
+  }
+
+  // Operator Overloads
+
+  // HyperDual-HyperDual binary ops
+  constexpr HyperDual operator+(const HyperDual &other) const {
+    return HyperDual(m_real + other.m_real,
+                     m_eps1 + other.m_eps1,
+                     m_eps2 + other.m_eps2,
+                     m_eps12 + other.m_eps12);
+  }
+
+  constexpr HyperDual operator-(const HyperDual &other) const {
+    return HyperDual(m_real - other.m_real,
+                     m_eps1 - other.m_eps1,
+                     m_eps2 - other.m_eps2,
+                     m_eps12 - other.m_eps12);
+  }
+
+  constexpr HyperDual operator*(const HyperDual &other) const {
+    return HyperDual(m_real * other.m_real,
+                     m_real * other.m_eps1 + m_eps1 * other.m_real,
+                     m_real * other.m_eps2 + m_eps2 * other.m_real,
+                     m_real * other.m_eps12 + m_eps1 * other.m_eps2 +
+                         m_eps2 * other.m_eps1 + m_eps12 * other.m_real);
+  }
+
+  // x / y = x · (1/y), with 1/y expanded through the chain rule
+  constexpr HyperDual operator/(const HyperDual &other) const {
+    const T inv = T(1) / other.m_real;
+    return *this * other.chain(inv, -inv * inv, T(2) * inv * inv * inv);
+  }
+
+  // HyperDual-Scalar binary ops
+  constexpr HyperDual operator+(const T &scalar) const {
+    return HyperDual(m_real + scalar, m_eps1, m_eps2, m_eps12);
+  }
+
+  constexpr HyperDual operator-(const T &scalar) const {
+    return HyperDual(m_real - scalar, m_eps1, m_eps2, m_eps12);
+  }
+
+  constexpr HyperDual operator*(const T &scalar) const {
+    return HyperDual(
+        m_real * scalar, m_eps1 * scalar, m_eps2 * scalar, m_eps12 * scalar);
+  }
+
+  constexpr HyperDual operator/(const T &scalar) const {
+    return HyperDual(
+        m_real / scalar, m_eps1 / scalar, m_eps2 / scalar, m_eps12 / scalar);
+  }
+
+  // Unary ops
+  constexpr HyperDual operator-() const {
+    return HyperDual(-m_real, -m_eps1, -m_eps2, -m_eps12);
+  }
+
+  // second-order chain rule for an elementary function g, given value = g(a),
+  // first = g'(a) and second = g''(a):
+  //   g(a) + g'(a) b ε1 + g'(a) c ε2 + (g'(a) d + g''(a) b c) ε1ε2
+  [[nodiscard]] constexpr HyperDual chain(T value, T first, T second) const {
+    return HyperDual(value,
+                     first * m_eps1,
+                     first * m_eps2,
+                     first * m_eps12 + second * m_eps1 * m_eps2);
+  }
+};
+
+// Scalar-HyperDual binary ops (free functions)
+template <typename T>
+constexpr HyperDual<T> operator+(const T &scalar, const HyperDual<T> &x) {
+  return x + scalar;
+}
+
+template <typename T>
+constexpr HyperDual<T> operator-(const T &scalar, const HyperDual<T> &x) {
+  return -x + scalar;
+}
+
+template <typename T>
+constexpr HyperDual<T> operator*(const T &scalar, const HyperDual<T> &x) {
+  return x * scalar;
+}
+
+template <typename T>
+constexpr HyperDual<T> operator/(const T &scalar, const HyperDual<T> &x) {
+  const T inv = T(1) / x.real();
+  return x.chain(inv, -inv * inv, T(2) * inv * inv * inv) * scalar;
+}
+
+// Integer-HyperDual binary ops (allows operations like 1 + x where x is HyperDual)
+template <typename T, std::integral I>
+constexpr HyperDual<T> operator+(I scalar, const HyperDual<T> &x) {
+  return T(scalar) + x;
+}
+
+template <typename T, std::integral I>
+constexpr HyperDual<T> operator-(I scalar, const HyperDual<T> &x) {
+  return T(scalar) - x;
+}
+
+template <typename T, std::integral I>
+constexpr HyperDual<T> operator*(I scalar, const HyperDual<T> &x) {
+  return T(scalar) * x;
+}
+
+template <typename T, std::integral I>
+constexpr HyperDual<T> operator/(I scalar, const HyperDual<T> &x) {
+  return T(scalar) / x;
+}
+
+// Elementary operations
+// Each one supplies g(a), g'(a) and g''(a) to the second-order chain rule
+
+// sqrt: g' = 1/(2 sqrt(a)), g'' = −g'/(2a)
+template <typename T>
+constexpr HyperDual<T> sqrt(const HyperDual<T> &x) {
+  const T r = constexpr_math::sqrt(x.real());
+  const T first = T(1) / (T(2) * r);
+  return x.chain(r, first, -first / (T(2) * x.real()));
+}
+
+// pow: g' = n a^{n-1}, g'' = n (n-1) a^{n-2}
+template <typename T>
+constexpr HyperDual<T> pow(const HyperDual<T> &x, const T &n) {
+  const T a = x.real();
+  return x.chain(constexpr_math::pow(a, n),
+                 n * constexpr_math::pow(a, n - T(1)),
+                 n * (n - T(1)) * constexpr_math::pow(a, n - T(2)));
+}
+
+// Overload for integer exponents (allows pow(x, 2) instead of pow(x, 2.0))
+template <typename T, std::integral I>
+constexpr HyperDual<T> pow(const HyperDual<T> &x, I n) {
+  return pow(x, T(n));
+}
+
+// exp: g' = g'' = exp(a)
+template <typename T>
+constexpr HyperDual<T> exp(const HyperDual<T> &x) {
+  const T r = constexpr_math::exp(x.real());
+  return x.chain(r, r, r);
+}
+
+// log: g' = 1/a, g'' = −1/a^2
+template <typename T>
+constexpr HyperDual<T> log(const HyperDual<T> &x) {
+  const T inv = T(1) / x.real();
+  return x.chain(constexpr_math::log(x.real()), inv, -inv * inv);
+}
+
+// sin: g' = cos(a), g'' = −sin(a)
+template <typename T>
+constexpr HyperDual<T> sin(const HyperDual<T> &x) {
+  const T s = constexpr_math::sin(x.real());
+  return x.chain(s, constexpr_math::cos(x.real()), -s);
+}
+
+// cos: g' = −sin(a), g'' = −cos(a)
+template <typename T>
+constexpr HyperDual<T> cos(const HyperDual<T> &x) {
+  const T c = constexpr_math::cos(x.real());
+  return x.chain(c, -constexpr_math::sin(x.real()), -c);
+}
+
+// tan: g' = 1 + tan(a)^2, g'' = 2 tan(a) (1 + tan(a)^2)
+template <typename T>
+constexpr HyperDual<T> tan(const HyperDual<T> &x) {
+  const T r = constexpr_math::tan(x.real());
+  const T first = T(1) + r * r;
+  return x.chain(r, first, T(2) * r * first);
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+
+// Explicit SIMD kernels use std::experimental::simd when the standard library ships it.
+// Define GRADUAL_NO_SIMD to force the scalar fallback loops.
+#if !defined(GRADUAL_NO_SIMD) && __has_include(<experimental/simd>)
+#include <experimental/simd>
+#define GRADUAL_HAS_SIMD 1
+#else
+#define GRADUAL_HAS_SIMD 0
+#endif
+
+// Fixed-size storage for the K tangent lanes of a multi-lane dual number.
+// Storage is aligned to the native SIMD register and padded to a whole number of
+// registers, so every kernel below runs full-width loads/stores with no scalar
+// remainder. Padding lanes start at zero and are never exposed through values().
+// The register width follows the target flags (e.g. -march=native picks AVX2/AVX-512).
+// In constant evaluation, or without <experimental/simd>, kernels fall back to plain
+// loops over the padded storage.
+template <typename T, std::size_t K>
+  requires std::floating_point<T> && (K > 0)
+class Lanes {
+#if GRADUAL_HAS_SIMD
+  using simd_type = std::experimental::native_simd<T>;
+
+public:
+  static constexpr std::size_t width = simd_type::size();
+  static constexpr std::size_t alignment =
+      std::experimental::memory_alignment_v<simd_type>;
+#else
+public:
+  static constexpr std::size_t width = sizeof(T) < 16 ? 16 / sizeof(T) : 1;
+  static constexpr std::size_t alignment = width * sizeof(T);
+#endif
+  static constexpr std::size_t padded = (K + width - 1) / width * width;
+
+private:
+  alignas(alignment) std::array<T, padded> m_data{};
+
+  // result[k] = op(a[k], b[k]) for every (padded) lane
+  // op must be a generic callable, it receives either scalars or SIMD registers
+  template <typename Op>
+  static constexpr Lanes apply(const Lanes &a, const Lanes &b, Op op) {
+    Lanes result;
+#if GRADUAL_HAS_SIMD
+    if (not std::is_constant_evaluated()) {
+      constexpr auto aligned = std::experimental::vector_aligned;
+      for (std::size_t k = 0; k < padded; k += width) {
+        const simd_type x(&a.m_data[k], aligned);
+        const simd_type y(&b.m_data[k], aligned);
+        simd_type r = op(x, y);
+        r.copy_to(&result.m_data[k], aligned);
+      }
+      return result;
+    }
+#endif
+    for (std::size_t k = 0; k < padded; k++)
+      result.m_data[k] = op(a.m_data[k], b.m_data[k]);
+    return result;
+  }
+
+public:
+  // Constructor
+  constexpr Lanes() = default;
+  constexpr Lanes(const std::array<T, K> &values) {
+    for (std::size_t k = 0; k < K; k++)
+      m_data[k] = values[k];
+  }
+
+  // Accessors
+  constexpr T operator[](std::size_t lane) const {
+    return m_data[lane];
+  }
+  constexpr T &operator[](std::size_t lane) {
+    return m_data[lane];
+  }
+  [[nodiscard]] constexpr std::span<const T, K> values() const {
+    return std::span<const T, K>(m_data.data(), K);
+  }
+
+  // Kernels
+
+  // a + b
+  static constexpr Lanes add(const Lanes &a, const Lanes &b) {
+    return apply(a, b, [](auto x, auto y) { return x + y; });
+  }
+
+  // a - b
+  static constexpr Lanes sub(const Lanes &a, const Lanes &b) {
+    return apply(a, b, [](auto x, auto y) { return x - y; });
+  }
+
+  // s·a
+  static constexpr Lanes scale(T s, const Lanes &a) {
+    return apply(a, a, [s](auto x, auto) { return s * x; });
+  }
+
+  // α·a + β·b
+  static constexpr Lanes axpby(T alpha, const Lanes &a, T beta, const Lanes &b) {
+    return apply(a, b, [alpha, beta](auto x, auto y) { return alpha * x + beta * y; });
+  }
+};
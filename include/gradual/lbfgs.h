@@ -0,0 +1,248 @@
+#pragma once
+
+#include "dual.h"
+#include "gradient.h"
+#include "optimiser.h"
+#include "vector.h"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+// Ring buffer of the M most recent L-BFGS correction pairs
+//   s_k = x_{k+1} − x_k, y_k = ∇f(x_{k+1}) − ∇f(x_k)
+// All storage is fixed-size: the history lives on the stack of minimise().
+template <typename T, std::size_t N, std::size_t M>
+class LbfgsHistory {
+private:
+  std::array<Vector<T, N>, M> m_s{};
+  std::array<Vector<T, N>, M> m_y{};
+  std::array<T, M> m_rho{}; // 1 / (y_kᵀ s_k)
+  std::size_t m_head{0};    // slot of the next pair
+  std::size_t m_count{0};
+
+public:
+  [[nodiscard]] constexpr std::size_t size() const {
+    return m_count;
+  }
+
+  constexpr void clear() {
+    m_head = 0;
+    m_count = 0;
+  }
+
+  // store a pair, overwriting the oldest one when full
+  // pairs without positive curvature yᵀs > 0 are skipped to keep H positive definite
+  constexpr bool push(const Vector<T, N> &s, const Vector<T, N> &y) {
+    const T sy = s * y;
+    if (not(sy > std::numeric_limits<T>::epsilon() * (y * y)))
+      return false;
+
+    m_s[m_head] = s;
+    m_y[m_head] = y;
+    m_rho[m_head] = T(1) / sy;
+    m_head = (m_head + 1) % M;
+    m_count = std::min(m_count + 1, M);
+    return true;
+  }
+
+  // two-loop recursion: returns H·q, with H the L-BFGS inverse Hessian approximation
+  // scaled by γ = sᵀy / yᵀy of the newest pair
+  constexpr Vector<T, N> apply(Vector<T, N> q) const {
+    std::array<T, M> alpha{};
+
+    // newest to oldest
+    for (std::size_t n = 0; n < m_count; n++) {
+      const std::size_t k = (m_head + M - 1 - n) % M;
+      alpha[k] = m_rho[k] * (m_s[k] * q);
+      q = q - m_y[k] * alpha[k];
+    }
+
+    if (m_count > 0) {
+      const std::size_t newest = (m_head + M - 1) % M;
+      q = q * (T(1) / (m_rho[newest] * (m_y[newest] * m_y[newest])));
+    }
+
+    // oldest to newest
+    for (std::size_t n = m_count; n-- > 0;) {
+      const std::size_t k = (m_head + M - 1 - n) % M;
+      const T beta = m_rho[k] * (m_y[k] * q);
+      q = q + m_s[k] * (alpha[k] - beta);
+    }
+
+    return q;
+  }
+};
+
+// Limited-memory BFGS minimiser with box constraints (L-BFGS-B-style projection).
+//   - the search direction is the two-loop L-BFGS direction restricted to the free
+//     variables; variables on a bound whose gradient points out of the box are held
+//   - a backtracking line search along the projected path P(x + α d) enforces the
+//     Armijo condition f(x(α)) ≤ f(x) + c1 ∇fᵀ(x(α) − x)
+//   - convergence is tested on the projected gradient |P(x − ∇f) − x|, which vanishes
+//     at a constrained minimum even where ∇f itself does not
+// M is the number of stored correction pairs; Gradient selects the backend as in
+// Optimiser.
+template <typename T, std::size_t M = 8, typename Gradient = ForwardGradient>
+  requires(M > 0)
+class LbfgsOptimiser {
+private:
+  T m_grad_tol{};
+  std::size_t m_max_iterations{};
+  Gradient m_gradient{};
+
+  static constexpr T armijo_c1 = T(1e-4);
+  static constexpr std::size_t max_backtracks = 40;
+
+  // f at point, with zero dual parts
+  template <std::size_t N, typename Func>
+  static constexpr T evaluate(Func f, const Vector<T, N> &point) {
+    return [&]<std::size_t... Indices>(std::index_sequence<Indices...>) {
+      return f(Dual<T>(point[Indices], T(0))...).real();
+    }(std::make_index_sequence<N>{});
+  }
+
+  // x clamped into [lower, upper]; x may be an expression, N comes from the bounds
+  template <std::size_t N>
+  static constexpr Vector<T, N> project(std::type_identity_t<Vector<T, N>> x,
+                                        const Vector<T, N> &lower,
+                                        const Vector<T, N> &upper) {
+    for (std::size_t i = 0; i < N; i++)
+      x[i] = std::clamp(x[i], lower[i], upper[i]);
+    return x;
+  }
+
+public:
+  constexpr LbfgsOptimiser(T grad_tol, std::size_t max_iterations = 1000)
+      : m_grad_tol(grad_tol), m_max_iterations(max_iterations) {
+  }
+
+  // bounded minimisation, (lower, upper)
+  template <std::size_t N, typename Func>
+  constexpr Result<T, N> minimise(Func f,
+                                  const Vector<T, N> &start,
+                                  const Vector<T, N> &lower,
+                                  const Vector<T, N> &upper) {
+    std::size_t num_iterations{0}, num_function_evaluations{0};
+    std::size_t num_gradient_evaluations{1};
+    LbfgsHistory<T, N, M> history;
+
+    // f and ∇f at the projected start, from the same passes
+    Vector<T, N> params{project(start, lower, upper)};
+    FirstOrder<T, N> initial{m_gradient.value_and_gradient(f, params)};
+    T value{initial.value};
+    Vector<T, N> grad_vec{initial.gradient};
+
+    // projected gradient norm, |P(x − ∇f) − x|
+    auto projected_norm = [&]() {
+      return (project(params - grad_vec, lower, upper) - params).norm();
+    };
+    T grad_norm{projected_norm()};
+
+    while (grad_norm > m_grad_tol and num_iterations < m_max_iterations) {
+      num_iterations++;
+
+      // variables held on their bound this iteration
+      std::array<bool, N> held{};
+      for (std::size_t i = 0; i < N; i++)
+        held[i] = (params[i] <= lower[i] and grad_vec[i] > T(0)) or
+                  (params[i] >= upper[i] and grad_vec[i] < T(0));
+
+      // L-BFGS direction on the free variables
+      Vector<T, N> free_grad{grad_vec};
+      for (std::size_t i = 0; i < N; i++)
+        if (held[i])
+          free_grad[i] = T(0);
+      Vector<T, N> direction{history.apply(free_grad) * T(-1)};
+      for (std::size_t i = 0; i < N; i++)
+        if (held[i])
+          direction[i] = T(0);
+
+      // not a descent direction: restart from steepest descent
+      if (not(direction * grad_vec < T(0))) {
+        history.clear();
+        direction = free_grad * T(-1);
+      }
+
+      // first iteration has no curvature information: unit step along the
+      // normalised gradient
+      T alpha{history.size() == 0 ? T(1) / std::max(direction.norm(), T(1)) : T(1)};
+
+      // backtracking along the projected path
+      // an f that does not accept Dual<T> (e.g. Var<T> only, for ReverseGradient) is
+      // evaluated by the backend, and the gradient of the accepted trial is kept
+      Vector<T, N> candidate{};
+      T candidate_value{};
+      FirstOrder<T, N> trial{};
+      bool accepted{false};
+      for (std::size_t n = 0; n < max_backtracks; n++) {
+        candidate = project(params + direction * alpha, lower, upper);
+        if constexpr (unpacked_invocable<Func, Dual<T>, N>) {
+          candidate_value = evaluate(f, candidate);
+        } else {
+          trial = m_gradient.value_and_gradient(f, candidate);
+          candidate_value = trial.value;
+          num_gradient_evaluations++;
+        }
+        num_function_evaluations++;
+        if (candidate_value <= value + armijo_c1 * (grad_vec * (candidate - params))) {
+          accepted = true;
+          break;
+        }
+        alpha /= T(2);
+      }
+
+      // no decrease left at floating-point resolution
+      if (not accepted)
+        break;
+
+      // f and ∇f at the accepted point from the same passes; for an f without Dual<T>
+      // support the search already computed both
+      if constexpr (unpacked_invocable<Func, Dual<T>, N>) {
+        trial = m_gradient.value_and_gradient(f, candidate);
+        num_gradient_evaluations++;
+      }
+      history.push(candidate - params, trial.gradient - grad_vec);
+
+      params = candidate;
+      value = trial.value;
+      grad_vec = trial.gradient;
+      grad_norm = projected_norm();
+    }
+
+    const bool converged = grad_norm <= m_grad_tol;
+    return Result<T, N>(params,
+                        value,
+                        grad_norm,
+                        num_iterations,
+                        converged,
+                        num_function_evaluations,
+                        num_gradient_evaluations);
+  }
+
+  // unbounded minimisation, (-infty, infty)
+  template <std::size_t N, typename Func>
+  constexpr Result<T, N> minimise(Func f, const Vector<T, N> &start) {
+    Vector<T, N> lower{}, upper{};
+    for (std::size_t i = 0; i < N; i++) {
+      lower[i] = -std::numeric_limits<T>::max();
+      upper[i] = std::numeric_limits<T>::max();
+    }
+    return minimise(f, start, lower, upper);
+  }
+
+  // unbounded minimisation from zero starting point
+  template <std::size_t N, typename Func>
+  constexpr Result<T, N> minimise_from_zero(Func f) {
+    return minimise(f, Vector<T, N>{});
+  }
+
+  // bounded minimisation from zero starting point
+  template <std::size_t N, typename Func>
+  constexpr Result<T, N>
+  minimise_from_zero(Func f, const Vector<T, N> &lower, const Vector<T, N> &upper) {
+    return minimise(f, Vector<T, N>{}, lower, upper);
+  }
+};
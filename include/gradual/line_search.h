@@ -0,0 +1,143 @@
+#pragma once
+
+#include "constexpr_math.h"
+#include <algorithm>
+#include <cstddef>
+
+// Line-search policies for Optimiser.
+// A policy picks the step length α along a search direction d from x, given
+//   φ(α) = f(P(x + α d))
+// where P clamps into the bounds. Each policy is a callable
+//   LineSearchStep<T> operator()(Phi phi, LineSample<T> start, T initial_step)
+// where start holds φ(0) and φ'(0) < 0, and phi(α) returns φ(α) and φ'(α) from a
+// single Dual evaluation seeded along d, so a trial step costs one pass of f
+// whatever the dimension.
+
+// φ(α) and φ'(α)
+template <typename T>
+struct LineSample {
+  T value{};
+  T slope{};
+};
+
+template <typename T>
+struct LineSearchStep {
+  T step{};            // accepted α
+  bool accepted{true}; // false if no step with sufficient decrease was found
+};
+
+// constant step, no trial evaluations (the original Optimiser behaviour)
+template <typename T>
+struct FixedStep {
+  template <typename Phi>
+  constexpr LineSearchStep<T> operator()(Phi, const LineSample<T> &, T step) const {
+    return {step, true};
+  }
+};
+
+// backtracking until the Armijo (sufficient decrease) condition holds
+//   φ(α) ≤ φ(0) + c1 α φ'(0)
+template <typename T>
+struct Armijo {
+  T c1{T(1e-4)};
+  T shrink{T(0.5)};
+  std::size_t max_evaluations{40};
+
+  template <typename Phi>
+  constexpr LineSearchStep<T>
+  operator()(Phi phi, const LineSample<T> &start, T step) const {
+    for (std::size_t n = 0; n < max_evaluations; n++) {
+      const LineSample<T> trial = phi(step);
+      if (trial.value <= start.value + c1 * step * start.slope)
+        return {step, true};
+      step *= shrink;
+    }
+    return {T(0), false};
+  }
+};
+
+// bracketing and zoom until the strong Wolfe conditions hold
+//   φ(α) ≤ φ(0) + c1 α φ'(0)   and   |φ'(α)| ≤ c2 |φ'(0)|
+// following Nocedal & Wright, Numerical Optimization, algorithms 3.5 and 3.6
+template <typename T>
+struct StrongWolfe {
+  T c1{T(1e-4)};
+  T c2{T(0.9)};
+  T grow{T(2)};
+  std::size_t max_evaluations{40};
+
+  template <typename Phi>
+  constexpr LineSearchStep<T>
+  operator()(Phi phi, const LineSample<T> &start, T step) const {
+    std::size_t evaluations{0};
+
+    auto sufficient = [&](T alpha, const LineSample<T> &trial) {
+      return trial.value <= start.value + c1 * alpha * start.slope;
+    };
+    auto curvature = [&](const LineSample<T> &trial) {
+      return constexpr_math::abs(trial.slope) <= -c2 * start.slope;
+    };
+
+    // shrink the bracket [lo, hi] around a point satisfying both conditions
+    // lo always satisfies the sufficient decrease condition
+    auto zoom = [&](T lo, LineSample<T> lo_sample, T hi, LineSample<T> hi_sample) {
+      while (evaluations < max_evaluations) {
+        // minimiser of the quadratic through φ(lo), φ'(lo), φ(hi), kept away
+        // from the ends of the bracket; bisection otherwise
+        const T width = hi - lo;
+        const T denom =
+            T(2) * (hi_sample.value - lo_sample.value - lo_sample.slope * width);
+        T alpha = lo + width / T(2);
+        if (denom > T(0)) {
+          const T quadratic = lo - lo_sample.slope * width * width / denom;
+          const T a = std::min(lo, hi) + T(0.1) * constexpr_math::abs(width);
+          const T b = std::max(lo, hi) - T(0.1) * constexpr_math::abs(width);
+          if (quadratic >= a and quadratic <= b)
+            alpha = quadratic;
+        }
+
+        const LineSample<T> trial = phi(alpha);
+        evaluations++;
+        if (not sufficient(alpha, trial) or trial.value >= lo_sample.value) {
+          hi = alpha;
+          hi_sample = trial;
+        } else {
+          if (curvature(trial))
+            return LineSearchStep<T>{alpha, true};
+          if (trial.slope * (hi - lo) >= T(0)) {
+            hi = lo;
+            hi_sample = lo_sample;
+          }
+          lo = alpha;
+          lo_sample = trial;
+        }
+      }
+      // out of budget: lo still gives sufficient decrease, if it moved at all
+      if (lo > T(0))
+        return LineSearchStep<T>{lo, true};
+      return LineSearchStep<T>{T(0), false};
+    };
+
+    T previous{0};
+    LineSample<T> previous_sample{start};
+    while (evaluations < max_evaluations) {
+      const LineSample<T> trial = phi(step);
+      evaluations++;
+
+      if (not sufficient(step, trial) or
+          (previous > T(0) and trial.value >= previous_sample.value))
+        return zoom(previous, previous_sample, step, trial);
+      if (curvature(trial))
+        return {step, true};
+      if (trial.slope >= T(0))
+        return zoom(step, trial, previous, previous_sample);
+
+      previous = step;
+      previous_sample = trial;
+      step *= grow;
+    }
+
+    // still descending after the whole budget: take the furthest point
+    return {previous, previous > T(0)};
+  }
+};
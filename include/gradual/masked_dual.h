@@ -0,0 +1,275 @@
+#pragma once
+
+#include "constexpr_math.h"
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+// Dual numbers whose dependency set is part of the type: MaskedDual<T, Mask> holds the
+// derivatives with respect to the inputs whose bit is set in Mask, and nothing else.
+//   - input i is seeded as MaskedDual<T, 1 << i>, with a single tangent
+//   - an operation on masks A and B returns mask A | B and only computes the lanes in
+//     it; a lane that one operand does not depend on is copied (or negated) from the
+//     other, with no multiplication or addition by zero
+// So x_i * x_i costs one tangent update whatever N, and in a sum of independent
+// per-parameter terms the tangent arithmetic of each term is limited to its own
+// dependencies. The running sum still carries the union of the masks so far, so
+// adding a term copies the lanes of the partial sum. The masks are resolved at
+// compile time, so f must let each argument keep its own type, e.g. a lambda with auto
+// parameters or a fold expression over a parameter pack.
+// Template parameter T must be a floating-point type, inputs are limited to 64.
+template <typename T, std::uint64_t Mask>
+  requires std::floating_point<T>
+class MaskedDual {
+public:
+  // number of stored tangents
+  static constexpr std::size_t size = std::popcount(Mask);
+
+private:
+  T m_real;
+  std::array<T, size> m_dual;
+
+  // lane of input i, i.e. the number of dependencies below it
+  static constexpr std::size_t lane_of(std::uint64_t mask, std::size_t i) {
+    return std::popcount(mask & ((std::uint64_t(1) << i) - 1));
+  }
+
+  // input of lane k, i.e. the k-th set bit
+  static constexpr std::size_t input_of(std::uint64_t mask, std::size_t k) {
+    for (std::size_t i = 0; i < 64; i++) {
+      if ((mask >> i) & 1) {
+        if (k == 0)
+          return i;
+        k--;
+      }
+    }
+    return 64;
+  }
+
+  // lanes of Mask | B, each computed from the operands that depend on its input:
+  // both(a, b), left(a) or right(b)
+  template <std::uint64_t B, typename Both, typename Left, typename Right>
+  constexpr std::array<T, std::popcount(Mask | B)>
+  combine(const std::array<T, std::popcount(B)> &other,
+          Both both,
+          Left left,
+          Right right) const {
+    constexpr std::uint64_t Out = Mask | B;
+    std::array<T, std::popcount(Out)> result{};
+    [&]<std::size_t... K>(std::index_sequence<K...>) {
+      (..., [&] {
+        constexpr std::size_t i = input_of(Out, K);
+        constexpr bool in_a = (Mask >> i) & 1, in_b = (B >> i) & 1;
+        if constexpr (in_a and in_b)
+          result[K] = both(m_dual[lane_of(Mask, i)], other[lane_of(B, i)]);
+        else if constexpr (in_a)
+          result[K] = left(m_dual[lane_of(Mask, i)]);
+        else
+          result[K] = right(other[lane_of(B, i)]);
+      }());
+    }(std::make_index_sequence<std::popcount(Out)>{});
+    return result;
+  }
+
+public:
+  // Public type alias to support concept detection in Vector
+  using value_type = T;
+  static constexpr std::uint64_t mask = Mask;
+
+  // Constructor
+  constexpr MaskedDual() : m_real(T(0)), m_dual{} {
+  }
+  constexpr MaskedDual(T real, const std::array<T, size> &dual)
+      : m_real(real), m_dual(dual) {
+  }
+
+  // input x_i = real, with ∂x_i/∂x_i = 1
+  static constexpr MaskedDual variable(T real)
+    requires(size == 1)
+  {
+    return MaskedDual(real, {T(1)});
+  }
+
+  // Accessors
+  [[nodiscard]] constexpr T real() const {
+    return m_real;
+  }
+  // ∂/∂x_i, 0 for inputs outside of Mask
+  [[nodiscard]] constexpr T dual(std::size_t i) const {
+    return i < 64 and ((Mask >> i) & 1) ? m_dual[lane_of(Mask, i)] : T(0);
+  }
+  [[nodiscard]] constexpr const std::array<T, size> &duals() const {
+    return m_dual;
+  }
+
+  // Operator Overloads
+
+  // MaskedDual-MaskedDual binary ops, on the union of the dependencies
+  template <std::uint64_t B>
+  constexpr auto operator+(const MaskedDual<T, B> &other) const {
+    const auto dual = combine<B>(
+        other.duals(),
+        [](T a, T b) { return a + b; },
+        [](T a) { return a; },
+        [](T b) { return b; });
+    return MaskedDual<T, Mask | B>(m_real + other.real(), dual);
+  }
+
+  template <std::uint64_t B>
+  constexpr auto operator-(const MaskedDual<T, B> &other) const {
+    const auto dual = combine<B>(
+        other.duals(),
+        [](T a, T b) { return a - b; },
+        [](T a) { return a; },
+        [](T b) { return -b; });
+    return MaskedDual<T, Mask | B>(m_real - other.real(), dual);
+  }
+
+  // (a + b ε)(c + d ε) = ac + (c·b + a·d) ε
+  template <std::uint64_t B>
+  constexpr auto operator*(const MaskedDual<T, B> &other) const {
+    const T c = other.real(), a = m_real;
+    const auto dual = combine<B>(
+        other.duals(),
+        [c, a](T b, T d) { return c * b + a * d; },
+        [c](T b) { return c * b; },
+        [a](T d) { return a * d; });
+    return MaskedDual<T, Mask | B>(a * c, dual);
+  }
+
+  // (a + b ε)/(c + d ε) = a/c + (b/c − a·d/c²) ε
+  template <std::uint64_t B>
+  constexpr auto operator/(const MaskedDual<T, B> &other) const {
+    const T inv = T(1) / other.real();
+    const T r = m_real * inv;
+    const auto dual = combine<B>(
+        other.duals(),
+        [inv, r](T b, T d) { return inv * b - r * inv * d; },
+        [inv](T b) { return inv * b; },
+        [inv, r](T d) { return -r * inv * d; });
+    return MaskedDual<T, Mask | B>(r, dual);
+  }
+
+  // MaskedDual-Scalar binary ops
+  constexpr MaskedDual operator+(const T &scalar) const {
+    return MaskedDual(m_real + scalar, m_dual);
+  }
+
+  constexpr MaskedDual operator-(const T &scalar) const {
+    return MaskedDual(m_real - scalar, m_dual);
+  }
+
+  constexpr MaskedDual operator*(const T &scalar) const {
+    return chain(m_real * scalar, scalar);
+  }
+
+  constexpr MaskedDual operator/(const T &scalar) const {
+    return chain(m_real / scalar, T(1) / scalar);
+  }
+
+  // Unary ops
+  constexpr MaskedDual operator-() const {
+    return chain(-m_real, T(-1));
+  }
+
+  // chain rule for an elementary function g, given value = g(a) and derivative = g'(a)
+  [[nodiscard]] constexpr MaskedDual chain(T value, T derivative) const {
+    std::array<T, size> dual{};
+    for (std::size_t k = 0; k < size; k++)
+      dual[k] = derivative * m_dual[k];
+    return MaskedDual(value, dual);
+  }
+};
+
+// Scalar-MaskedDual binary ops (free functions)
+template <typename T, std::uint64_t Mask>
+constexpr MaskedDual<T, Mask> operator+(const T &scalar, const MaskedDual<T, Mask> &x) {
+  return x + scalar;
+}
+
+template <typename T, std::uint64_t Mask>
+constexpr MaskedDual<T, Mask> operator-(const T &scalar, const MaskedDual<T, Mask> &x) {
+  return x.chain(scalar - x.real(), T(-1));
+}
+
+template <typename T, std::uint64_t Mask>
+constexpr MaskedDual<T, Mask> operator*(const T &scalar, const MaskedDual<T, Mask> &x) {
+  return x * scalar;
+}
+
+template <typename T, std::uint64_t Mask>
+constexpr MaskedDual<T, Mask> operator/(const T &scalar, const MaskedDual<T, Mask> &x) {
+  return x.chain(scalar / x.real(), -scalar / (x.real() * x.real()));
+}
+
+// Integer-MaskedDual binary ops (allows operations like 1 + x)
+template <typename T, std::uint64_t Mask, std::integral I>
+constexpr MaskedDual<T, Mask> operator+(I scalar, const MaskedDual<T, Mask> &x) {
+  return T(scalar) + x;
+}
+
+template <typename T, std::uint64_t Mask, std::integral I>
+constexpr MaskedDual<T, Mask> operator-(I scalar, const MaskedDual<T, Mask> &x) {
+  return T(scalar) - x;
+}
+
+template <typename T, std::uint64_t Mask, std::integral I>
+constexpr MaskedDual<T, Mask> operator*(I scalar, const MaskedDual<T, Mask> &x) {
+  return T(scalar) * x;
+}
+
+template <typename T, std::uint64_t Mask, std::integral I>
+constexpr MaskedDual<T, Mask> operator/(I scalar, const MaskedDual<T, Mask> &x) {
+  return T(scalar) / x;
+}
+
+// Elementary operations
+// Same derivative rules as for Dual<T>, applied to the stored lanes only
+
+template <typename T, std::uint64_t Mask>
+constexpr MaskedDual<T, Mask> sqrt(const MaskedDual<T, Mask> &x) {
+  const T r = constexpr_math::sqrt(x.real());
+  return x.chain(r, T(1) / (T(2) * r));
+}
+
+template <typename T, std::uint64_t Mask>
+constexpr MaskedDual<T, Mask> pow(const MaskedDual<T, Mask> &x, const T &n) {
+  const T a = x.real();
+  return x.chain(constexpr_math::pow(a, n), n * constexpr_math::pow(a, n - T(1)));
+}
+
+// Overload for integer exponents (allows pow(x, 2) instead of pow(x, 2.0))
+template <typename T, std::uint64_t Mask, std::integral I>
+constexpr MaskedDual<T, Mask> pow(const MaskedDual<T, Mask> &x, I n) {
+  return pow(x, T(n));
+}
+
+template <typename T, std::uint64_t Mask>
+constexpr MaskedDual<T, Mask> exp(const MaskedDual<T, Mask> &x) {
+  const T r = constexpr_math::exp(x.real());
+  return x.chain(r, r);
+}
+
+template <typename T, std::uint64_t Mask>
+constexpr MaskedDual<T, Mask> log(const MaskedDual<T, Mask> &x) {
+  return x.chain(constexpr_math::log(x.real()), T(1) / x.real());
+}
+
+template <typename T, std::uint64_t Mask>
+constexpr MaskedDual<T, Mask> sin(const MaskedDual<T, Mask> &x) {
+  return x.chain(constexpr_math::sin(x.real()), constexpr_math::cos(x.real()));
+}
+
+template <typename T, std::uint64_t Mask>
+constexpr MaskedDual<T, Mask> cos(const MaskedDual<T, Mask> &x) {
+  return x.chain(constexpr_math::cos(x.real()), -constexpr_math::sin(x.real()));
+}
+
+template <typename T, std::uint64_t Mask>
+constexpr MaskedDual<T, Mask> tan(const MaskedDual<T, Mask> &x) {
+  const T r = constexpr_math::tan(x.real());
+  return x.chain(r, T(1) + r * r);
+}
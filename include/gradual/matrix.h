@@ -0,0 +1,128 @@
+#pragma once
+
+#include "constexpr_math.h"
+#include "vector.h"
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+
+// Fixed-size dense R×C matrix, stored row-major.
+// Used for Hessians and Jacobians; supports element access and matrix-vector product.
+// Template parameter T must be floating-point.
+template <typename T, std::size_t R, std::size_t C>
+  requires std::floating_point<T>
+class Matrix {
+private:
+  std::array<T, R * C> m_data{};
+
+public:
+  // Constructor
+  constexpr Matrix() = default;
+
+  // identity matrix (square matrices only)
+  static constexpr Matrix identity()
+    requires(R == C)
+  {
+    Matrix result;
+    for (std::size_t i = 0; i < R; i++)
+      result(i, i) = T(1);
+    return result;
+  }
+
+  // Accessors
+  [[nodiscard]] constexpr std::size_t rows() const {
+    return R;
+  }
+  [[nodiscard]] constexpr std::size_t cols() const {
+    return C;
+  }
+  // unchecked unless GRADUAL_BOUNDS_CHECK is defined, as Vector::operator[]
+  constexpr const T &operator()(std::size_t row, std::size_t col) const {
+#ifdef GRADUAL_BOUNDS_CHECK
+    return at(row, col);
+#else
+    return m_data[row * C + col];
+#endif
+  }
+  constexpr T &operator()(std::size_t row, std::size_t col) {
+#ifdef GRADUAL_BOUNDS_CHECK
+    return at(row, col);
+#else
+    return m_data[row * C + col];
+#endif
+  }
+
+  // bounds-checked access, throws std::out_of_range
+  constexpr const T &at(std::size_t row, std::size_t col) const {
+    if (row >= R or col >= C)
+      throw std::out_of_range("Matrix::at");
+    return m_data[row * C + col];
+  }
+  constexpr T &at(std::size_t row, std::size_t col) {
+    if (row >= R or col >= C)
+      throw std::out_of_range("Matrix::at");
+    return m_data[row * C + col];
+  }
+
+  // Matrix-Vector product
+  constexpr Vector<T, R> operator*(const Vector<T, C> &vec) const {
+    Vector<T, R> result;
+    for (std::size_t i = 0; i < R; i++) {
+      T sum(0);
+      for (std::size_t j = 0; j < C; j++)
+        sum += (*this)(i, j) * vec[j];
+      result[i] = sum;
+    }
+    return result;
+  }
+};
+
+// solve A x = b for a symmetric positive-definite A, via Cholesky factorisation
+// A = L Lᵀ computed in place on the stack
+// returns std::nullopt if A is not (numerically) positive definite
+template <typename T, std::size_t N>
+constexpr std::optional<Vector<T, N>>
+cholesky_solve(const Matrix<T, N, N> &a, const std::type_identity_t<Vector<T, N>> &b) {
+  Matrix<T, N, N> lower;
+
+  // factorise, column by column
+  for (std::size_t j = 0; j < N; j++) {
+    T diag = a(j, j);
+    for (std::size_t k = 0; k < j; k++)
+      diag -= lower(j, k) * lower(j, k);
+    if (not(diag > T(0)))
+      return std::nullopt;
+    lower(j, j) = constexpr_math::sqrt(diag);
+
+    for (std::size_t i = j + 1; i < N; i++) {
+      T sum = a(i, j);
+      for (std::size_t k = 0; k < j; k++)
+        sum -= lower(i, k) * lower(j, k);
+      lower(i, j) = sum / lower(j, j);
+    }
+  }
+
+  // forward substitution, L y = b
+  Vector<T, N> y;
+  for (std::size_t i = 0; i < N; i++) {
+    T sum = b[i];
+    for (std::size_t k = 0; k < i; k++)
+      sum -= lower(i, k) * y[k];
+    y[i] = sum / lower(i, i);
+  }
+
+  // back substitution, Lᵀ x = y
+  Vector<T, N> x;
+  for (std::size_t i = N; i-- > 0;) {
+    T sum = y[i];
+    for (std::size_t k = i + 1; k < N; k++)
+      sum -= lower(k, i) * x[k];
+    x[i] = sum / lower(i, i);
+  }
+
+  return x;
+}
@@ -0,0 +1,193 @@
+#pragma once
+
+#include "constexpr_math.h"
+#include "lanes.h"
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <span>
+
+// Multi-lane dual numbers represent values of the form a + Σ_k b_k ε_k where
+// ε_i ε_j = 0 for all i, j. Each lane k carries the derivative along its own seed
+// direction, so a single evaluation of f yields K directional derivatives at once.
+// Template parameter T must be a floating-point type, K is the number of lanes.
+template <typename T, std::size_t K>
+  requires std::floating_point<T> && (K > 0)
+class MultiDual {
+private:
+  T m_real;
+  Lanes<T, K> m_dual; // aligned, padded tangent storage updated by SIMD kernels
+
+  constexpr MultiDual(T real, const Lanes<T, K> &dual) : m_real(real), m_dual(dual) {
+  }
+
+public:
+  // Public type alias to support concept detection in Vector
+  using value_type = T;
+  static constexpr std::size_t lanes = K;
+
+  // Constructor
+  constexpr MultiDual() : m_real(T(0)), m_dual{} {
+  }
+  constexpr MultiDual(T real, const std::array<T, K> &dual)
+      : m_real(real), m_dual(dual) {
+  }
+
+  // Accessors
+  [[nodiscard]] constexpr T real() const {
+    return m_real;
+  }
+  [[nodiscard]] constexpr T dual(std::size_t lane) const {
+    return m_dual[lane];
+  }
+  [[nodiscard]] constexpr std::span<const T, K> duals() const {
+    return m_dual.values();
+  }
+
+  // Operator Overloads
+  // Every tangent update is a single kernel call: all lanes share the same factors
+
+  // MultiDual-MultiDual binary ops
+  constexpr MultiDual operator+(const MultiDual &other) const {
+    return MultiDual(this->m_real + other.m_real,
+                     Lanes<T, K>::add(this->m_dual, other.m_dual));
+  }
+
+  constexpr MultiDual operator-(const MultiDual &other) const {
+    return MultiDual(this->m_real - other.m_real,
+                     Lanes<T, K>::sub(this->m_dual, other.m_dual));
+  }
+
+  // (a + b ε)(c + d ε) = ac + (c·b + a·d) ε
+  constexpr MultiDual operator*(const MultiDual &other) const {
+    return MultiDual(
+        this->m_real * other.m_real,
+        Lanes<T, K>::axpby(other.m_real, this->m_dual, this->m_real, other.m_dual));
+  }
+
+  // (a + b ε)/(c + d ε) = a/c + (b/c − a·d/c²) ε
+  constexpr MultiDual operator/(const MultiDual &other) const {
+    const T inv = T(1) / other.m_real;
+    const T r = this->m_real * inv;
+    return MultiDual(r, Lanes<T, K>::axpby(inv, this->m_dual, -r * inv, other.m_dual));
+  }
+
+  // MultiDual-Scalar binary ops
+  constexpr MultiDual operator+(const T &scalar) const {
+    return MultiDual(this->m_real + scalar, this->m_dual);
+  }
+
+  constexpr MultiDual operator-(const T &scalar) const {
+    return MultiDual(this->m_real - scalar, this->m_dual);
+  }
+
+  constexpr MultiDual operator*(const T &scalar) const {
+    return this->chain(this->m_real * scalar, scalar);
+  }
+
+  constexpr MultiDual operator/(const T &scalar) const {
+    return this->chain(this->m_real / scalar, T(1) / scalar);
+  }
+
+  // Unary ops
+  constexpr MultiDual operator-() const {
+    return this->chain(-this->m_real, T(-1));
+  }
+
+  // chain rule for an elementary function g: returns g(a) + Σ_k g'(a) b_k ε_k,
+  // given value = g(a) and derivative = g'(a)
+  [[nodiscard]] constexpr MultiDual chain(T value, T derivative) const {
+    return MultiDual(value, Lanes<T, K>::scale(derivative, this->m_dual));
+  }
+};
+
+// Scalar-MultiDual binary ops (free functions)
+template <typename T, std::size_t K>
+constexpr MultiDual<T, K> operator+(const T &scalar, const MultiDual<T, K> &x) {
+  return x + scalar;
+}
+
+template <typename T, std::size_t K>
+constexpr MultiDual<T, K> operator-(const T &scalar, const MultiDual<T, K> &x) {
+  return x.chain(scalar - x.real(), T(-1));
+}
+
+template <typename T, std::size_t K>
+constexpr MultiDual<T, K> operator*(const T &scalar, const MultiDual<T, K> &x) {
+  return x * scalar;
+}
+
+template <typename T, std::size_t K>
+constexpr MultiDual<T, K> operator/(const T &scalar, const MultiDual<T, K> &x) {
+  const T denom = x.real() * x.real();
+  return x.chain(scalar / x.real(), -scalar / denom);
+}
+
+// Integer-MultiDual binary ops (allows operations like 1 + x where x is MultiDual)
+template <typename T, std::size_t K, std::integral I>
+constexpr MultiDual<T, K> operator+(I scalar, const MultiDual<T, K> &x) {
+  return T(scalar) + x;
+}
+
+template <typename T, std::size_t K, std::integral I>
+constexpr MultiDual<T, K> operator-(I scalar, const MultiDual<T, K> &x) {
+  return T(scalar) - x;
+}
+
+template <typename T, std::size_t K, std::integral I>
+constexpr MultiDual<T, K> operator*(I scalar, const MultiDual<T, K> &x) {
+  return T(scalar) * x;
+}
+
+template <typename T, std::size_t K, std::integral I>
+constexpr MultiDual<T, K> operator/(I scalar, const MultiDual<T, K> &x) {
+  return T(scalar) / x;
+}
+
+// Elementary operations
+// Same derivative rules as for Dual<T>, applied to every lane with the same factor
+
+template <typename T, std::size_t K>
+constexpr MultiDual<T, K> sqrt(const MultiDual<T, K> &x) {
+  const T r = constexpr_math::sqrt(x.real());
+  return x.chain(r, T(1) / (T(2) * r));
+}
+
+template <typename T, std::size_t K>
+constexpr MultiDual<T, K> pow(const MultiDual<T, K> &x, const T &n) {
+  const T a = x.real();
+  return x.chain(constexpr_math::pow(a, n), n * constexpr_math::pow(a, n - T(1)));
+}
+
+// Overload for integer exponents (allows pow(x, 2) instead of pow(x, 2.0))
+template <typename T, std::size_t K, std::integral I>
+constexpr MultiDual<T, K> pow(const MultiDual<T, K> &x, I n) {
+  return pow(x, T(n));
+}
+
+template <typename T, std::size_t K>
+constexpr MultiDual<T, K> exp(const MultiDual<T, K> &x) {
+  const T r = constexpr_math::exp(x.real());
+  return x.chain(r, r);
+}
+
+template <typename T, std::size_t K>
+constexpr MultiDual<T, K> log(const MultiDual<T, K> &x) {
+  return x.chain(constexpr_math::log(x.real()), T(1) / x.real());
+}
+
+template <typename T, std::size_t K>
+constexpr MultiDual<T, K> sin(const MultiDual<T, K> &x) {
+  return x.chain(constexpr_math::sin(x.real()), constexpr_math::cos(x.real()));
+}
+
+template <typename T, std::size_t K>
+constexpr MultiDual<T, K> cos(const MultiDual<T, K> &x) {
+  return x.chain(constexpr_math::cos(x.real()), -constexpr_math::sin(x.real()));
+}
+
+template <typename T, std::size_t K>
+constexpr MultiDual<T, K> tan(const MultiDual<T, K> &x) {
+  const T r = constexpr_math::tan(x.real());
+  return x.chain(r, T(1) + r * r);
+}
@@ -0,0 +1,188 @@
+#pragma once
+
+#include "observer.h"
+#include "optimiser.h"
+#include "thread_pool.h"
+#include "vector.h"
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+// Multi-start minimisation: independent fits from many starting points, spread over
+// a ThreadPool. Meant for multi-modal objectives, where a single start lands in
+// whichever basin it begins in.
+//   - each fit runs on its own copy of the optimiser, so stateful gradient backends
+//     (e.g. the tape of ReverseGradient) are never shared; f is shared and must be
+//     safe to call concurrently, e.g. a lambda that only reads its captures
+//   - fit i always starts from the same point and runs serially, so every result,
+//     and the best one, is identical whatever the number of threads
+//   - with a target value, the fits after the first one reaching it are skipped or
+//     cancelled; fits before it always complete, so the outcome stays deterministic
+
+template <typename T>
+struct MultistartOptions {
+  std::optional<T> target_value{}; // stop once a fit reaches f <= target_value
+  ThreadPool *pool{nullptr};       // default_thread_pool() if null
+};
+
+template <typename T, std::size_t N>
+class MultistartResult {
+private:
+  std::vector<std::optional<Result<T, N>>> m_results;
+  std::size_t m_best_index{};
+  bool m_target_reached{};
+
+public:
+  MultistartResult(std::vector<std::optional<Result<T, N>>> results,
+                   std::size_t best_index,
+                   bool target_reached)
+      : m_results(std::move(results)), m_best_index(best_index),
+        m_target_reached(target_reached) {
+  }
+
+  // result of every fit, in the order of the starts; empty if skipped or cancelled
+  const std::vector<std::optional<Result<T, N>>> &results() const {
+    return m_results;
+  }
+
+  // lowest value found; with a target, the first fit that reached it
+  const Result<T, N> &best() const {
+    return *m_results[m_best_index];
+  }
+
+  std::size_t best_index() const {
+    return m_best_index;
+  }
+
+  bool target_reached() const {
+    return m_target_reached;
+  }
+
+  std::size_t num_completed() const {
+    std::size_t completed{0};
+    for (const auto &result : m_results)
+      completed += result.has_value();
+    return completed;
+  }
+};
+
+// Starting points drawn uniformly in the box [lower, upper].
+// Point i only depends on (seed, i), never on the order in which points are drawn.
+template <typename T, std::size_t N>
+class UniformSampler {
+private:
+  Vector<T, N> m_lower, m_upper;
+  std::uint64_t m_seed{};
+
+public:
+  UniformSampler(const Vector<T, N> &lower,
+                 const Vector<T, N> &upper,
+                 std::uint64_t seed)
+      : m_lower(lower), m_upper(upper), m_seed(seed) {
+  }
+
+  Vector<T, N> operator()(std::size_t index) const {
+    std::seed_seq sequence{m_seed, std::uint64_t(index)};
+    std::mt19937_64 generator(sequence);
+    Vector<T, N> point{m_lower};
+    for (std::size_t i = 0; i < point.size(); i++) {
+      std::uniform_real_distribution<T> coordinate(m_lower[i], m_upper[i]);
+      point[i] = coordinate(generator);
+    }
+    return point;
+  }
+};
+
+// scalar type of the points returned by a sampler
+template <typename Sampler>
+using sampled_value_t =
+    typename std::invoke_result_t<const Sampler &, std::size_t>::value_type;
+
+// Starts from sampler(i) for i in [0, num_starts). Opt is any optimiser of the library
+// (Optimiser, LbfgsOptimiser, NewtonOptimiser); the ones taking an observer are also
+// cancelled mid-fit once an earlier fit reached the target.
+template <typename Opt, typename Func, typename Sampler>
+  requires std::invocable<const Sampler &, std::size_t>
+auto minimise_multistart(
+    const Opt &optimiser,
+    Func f,
+    const Sampler &sampler,
+    std::size_t num_starts,
+    const MultistartOptions<sampled_value_t<Sampler>> &options = {}) {
+  using Point = std::invoke_result_t<const Sampler &, std::size_t>;
+  using T = typename Point::value_type;
+  constexpr std::size_t N = Point::extent;
+  using Fit = Result<T, N>;
+
+  if (num_starts == 0)
+    throw std::invalid_argument("minimise_multistart: no starting point");
+
+  std::vector<std::optional<Fit>> results(num_starts);
+  // lowest index of a fit that reached the target, num_starts if none
+  std::atomic<std::size_t> first_hit{num_starts};
+
+  auto fit = [&](std::size_t index) {
+    if (index > first_hit.load(std::memory_order_relaxed))
+      return;
+
+    Opt local{optimiser};
+    const Point start = sampler(index);
+    bool cancelled{false};
+    auto observer = [&](const IterationInfo<T> &) {
+      cancelled = index > first_hit.load(std::memory_order_relaxed);
+      return not cancelled;
+    };
+    Fit result = [&] {
+      if constexpr (requires { local.minimise(f, start, observer); })
+        return local.minimise(f, start, observer);
+      else
+        return local.minimise(f, start);
+    }();
+    if (cancelled)
+      return;
+
+    if (options.target_value and result.value() <= *options.target_value) {
+      std::size_t hit = first_hit.load();
+      while (index < hit and not first_hit.compare_exchange_weak(hit, index)) {
+      }
+    }
+    results[index] = std::move(result);
+  };
+
+  ThreadPool &pool = options.pool != nullptr ? *options.pool : default_thread_pool();
+  pool.parallel_for(num_starts, fit);
+
+  // fits up to first_hit all completed, so the choice below does not depend on timing
+  const std::size_t hit = first_hit.load();
+  if (hit < num_starts) {
+    for (std::size_t i = hit + 1; i < num_starts; i++)
+      results[i].reset();
+    return MultistartResult<T, N>(std::move(results), hit, true);
+  }
+
+  std::size_t best{0};
+  for (std::size_t i = 1; i < num_starts; i++)
+    if (results[i]->value() < results[best]->value())
+      best = i;
+  return MultistartResult<T, N>(std::move(results), best, false);
+}
+
+// starts given explicitly
+template <typename Opt, typename Func, typename T, std::size_t N>
+MultistartResult<T, N> minimise_multistart(const Opt &optimiser,
+                                           Func f,
+                                           const std::vector<Vector<T, N>> &starts,
+                                           const MultistartOptions<T> &options = {}) {
+  return minimise_multistart(
+      optimiser,
+      f,
+      [&](std::size_t index) { return starts[index]; },
+      starts.size(),
+      options);
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <fmt/core.h>
+#include <type_traits>
+#include <vector>
+
+// Per-iteration instrumentation for Optimiser::minimise.
+// An observer is a callable invoked after every iteration with an IterationInfo<T>:
+//   - returning void, it only watches
+//   - returning bool, false stops the minimisation after that iteration
+// The default NoObserver does nothing: the call and the clock reads around it are
+// compiled out, so an unobserved minimise is as fast as before.
+
+template <typename T>
+struct IterationInfo {
+  std::size_t iteration{};                     // 1-based
+  T value{};                                   // f after the iteration
+  T grad_norm{};                               // |∇f| after the iteration
+  T step{};                                    // accepted step length α
+  std::size_t num_function_evaluations{};      // line-search passes of f
+  std::chrono::nanoseconds evaluation_time{};  // f and ∇f, including line search
+  std::chrono::nanoseconds update_time{};      // search direction and parameter update
+};
+
+struct NoObserver {
+  template <typename Info>
+  constexpr void operator()(const Info &) const {
+  }
+};
+
+// true if observer is the no-op default, so timing can be skipped
+template <typename Observer>
+inline constexpr bool is_no_observer_v =
+    std::is_same_v<std::remove_cvref_t<Observer>, NoObserver>;
+
+// invoke observer with an IterationInfo (or another progress record, e.g. the
+// EpochInfo of stochastic.h), false if it asked to stop
+template <typename Info, typename Observer>
+constexpr bool notify_observer(Observer &observer, const Info &info) {
+  using Returned = std::invoke_result_t<Observer &, const Info &>;
+  if constexpr (std::is_void_v<Returned>) {
+    observer(info);
+    return true;
+  } else {
+    return static_cast<bool>(observer(info));
+  }
+}
+
+// Observer keeping the whole convergence trace, e.g. to find where a slow fit spends
+// its time or to plot value and |∇f| against the iteration
+template <typename T>
+class ConvergenceRecorder {
+private:
+  std::vector<IterationInfo<T>> m_trace;
+
+public:
+  void operator()(const IterationInfo<T> &info) {
+    m_trace.push_back(info);
+  }
+
+  const std::vector<IterationInfo<T>> &trace() const {
+    return m_trace;
+  }
+
+  void clear() {
+    m_trace.clear();
+  }
+
+  std::chrono::nanoseconds total_evaluation_time() const {
+    std::chrono::nanoseconds total{0};
+    for (const IterationInfo<T> &info : m_trace)
+      total += info.evaluation_time;
+    return total;
+  }
+
+  std::chrono::nanoseconds total_update_time() const {
+    std::chrono::nanoseconds total{0};
+    for (const IterationInfo<T> &info : m_trace)
+      total += info.update_time;
+    return total;
+  }
+
+  // one CSV row per iteration, times in nanoseconds
+  void write_csv(std::FILE *out = stdout) const {
+    fmt::print(out,
+               "iteration,value,grad_norm,step,num_function_evaluations,"
+               "evaluation_ns,update_ns\n");
+    for (const IterationInfo<T> &info : m_trace)
+      fmt::print(out,
+                 "{},{},{},{},{},{},{}\n",
+                 info.iteration,
+                 info.value,
+                 info.grad_norm,
+                 info.step,
+                 info.num_function_evaluations,
+                 info.evaluation_time.count(),
+                 info.update_time.count());
+  }
+};
@@ -1,10 +1,16 @@
 #pragma once
 
+#include "dual.h"
 #include "gradient.h"
+#include "line_search.h"
+#include "observer.h"
 #include "vector.h"
 #include <algorithm>
+#include <chrono>
 #include <cstddef>
 #include <limits>
+#include <type_traits>
+#include <utility>
 
 template <typename T, std::size_t N>
 class Result {
@@ -14,15 +20,20 @@ private:
   T m_grad{};             // gradient value at minimum, which made the engine to stop
   std::size_t m_num_iterations{};
   bool m_converged{};
+  std::size_t m_num_function_evaluations{}; // value-only or line-search passes of f
+  std::size_t m_num_gradient_evaluations{}; // gradient (or higher-order) computations
 
 public:
   constexpr Result(const Vector<T, N> &point,
                    T value,
                    T grad,
                    std::size_t num_iterations,
-                   bool converged)
+                   bool converged,
+                   std::size_t num_function_evaluations = 0,
+                   std::size_t num_gradient_evaluations = 0)
       : m_point(point), m_value(value), m_grad(grad), m_num_iterations(num_iterations),
-        m_converged(converged) {
+        m_converged(converged), m_num_function_evaluations(num_function_evaluations),
+        m_num_gradient_evaluations(num_gradient_evaluations) {
   }
 
   constexpr const Vector<T, N> &point() const {
@@ -40,83 +51,249 @@ public:
   constexpr bool converged() const {
     return m_converged;
   }
+  constexpr std::size_t num_function_evaluations() const {
+    return m_num_function_evaluations;
+  }
+  constexpr std::size_t num_gradient_evaluations() const {
+    return m_num_gradient_evaluations;
+  }
 };
 
-template <typename T>
+// Gradient selects the differentiation backend, see gradient.h
+//   - ForwardGradient (default): one Dual<T> evaluation per dimension
+//   - LaneGradient<K>: K tangent lanes per evaluation, for generic functors
+//   - MaskedGradient: one evaluation, tangents limited to each value's dependencies
+//   - ParallelGradient<K>: the same passes over a ThreadPool, see parallel_gradient.h
+// LineSearch selects the step length along −∇f, see line_search.h
+//   - FixedStep<T> (default): always step, no extra evaluations
+//   - Armijo<T>, StrongWolfe<T>: step is the initial trial step of the search
+// A DynamicVector start (N = std::dynamic_extent) selects the runtime-size path: f
+// then takes one std::span of active scalars instead of N arguments.
+// Every minimise overload takes an optional observer as last argument, called after
+// each iteration with an IterationInfo<T>, see observer.h.
+// Bounded minimisation tests the projected gradient, i.e. ∇f without the variables
+// held on a bound, so a minimum on the boundary converges; Result::grad() reports it.
+// minimise is constexpr for a fixed-size start, a constexpr f and a constexpr backend
+// (not ReverseGradient or ParallelGradient), so a fixed problem can be solved at
+// compile time; observers are then called without timings.
+template <typename T,
+          typename Gradient = ForwardGradient,
+          typename LineSearch = FixedStep<T>>
 class Optimiser {
 private:
   T m_step{}, m_grad_tol{};
   std::size_t m_max_iterations{};
+  Gradient m_gradient{};
+  LineSearch m_line_search{};
 
 public:
-  Optimiser(T step, T grad_tol, std::size_t max_iterations = 10000)
-      : m_step(step), m_grad_tol(grad_tol), m_max_iterations(max_iterations) {
+  constexpr Optimiser(T step,
+                      T grad_tol,
+                      std::size_t max_iterations = 10000,
+                      LineSearch line_search = LineSearch{})
+      : m_step(step), m_grad_tol(grad_tol), m_max_iterations(max_iterations),
+        m_line_search(line_search) {
+  }
+
+  // gradient backend, e.g. to inspect the tape statistics of ReverseGradient
+  constexpr const Gradient &gradient_backend() const {
+    return m_gradient;
   }
 
   // bounded minimisation, (lower, upper)
-  template <std::size_t N, typename Func>
-  Result<T, N> minimise(Func f,
-                        const Vector<T, N> &start,
-                        const Vector<T, N> &lower,
-                        const Vector<T, N> &upper) {
-    std::size_t num_iterations{0};
+  template <std::size_t N, typename Func, typename Observer = NoObserver>
+  constexpr Result<T, N> minimise(Func f,
+                                  const Vector<T, N> &start,
+                                  const Vector<T, N> &lower,
+                                  const Vector<T, N> &upper,
+                                  Observer &&observer = Observer{}) {
+    // clock reads only when observed, and never during constant evaluation
+    using Clock = std::chrono::steady_clock;
+    auto now = [] {
+      if constexpr (is_no_observer_v<Observer>)
+        return Clock::time_point{};
+      else
+        return std::is_constant_evaluated() ? Clock::time_point{} : Clock::now();
+    };
+
+    std::size_t num_iterations{0}, num_function_evaluations{0};
+    std::size_t num_gradient_evaluations{1};
     Vector<T, N> params{start};
-    Vector<T, N> grad_vec{gradient(f, params)}; //  gradient at initial params
-    T grad_norm{grad_vec.norm()};               // initial |∇f|
+    const std::size_t n = params.size();
+    // f and ∇f at initial params, from the same passes
+    FirstOrder<T, N> current{m_gradient.value_and_gradient(f, params)};
     // TODO: early exit if starting point is out of bounds?
 
+    // active set: variables on a bound that −∇f points out of
+    //   - a pinned variable is frozen, its gradient entry is zeroed and, when the
+    //     backend supports it, it is no longer seeded
+    //   - the projected gradient is ∇f without the pinned entries; the pins are only
+    //     released after a complete gradient, once the free variables have converged
+    CoordinateMask<N> pinned{};
+    if constexpr (N == std::dynamic_extent)
+      pinned = CoordinateMask<N>(n, false);
+    bool any_pinned{false};
+    bool complete{true}; // pins taken from a complete gradient at params
+    auto pin = [&]() {
+      for (std::size_t i = 0; i < n; i++) {
+        const T g = current.gradient[i];
+        if ((params[i] <= lower[i] and g > T(0)) or
+            (params[i] >= upper[i] and g < T(0))) {
+          pinned[i] = true;
+          any_pinned = true;
+        }
+        if (pinned[i])
+          current.gradient[i] = T(0);
+      }
+    };
+    auto complete_gradient = [&]() {
+      num_gradient_evaluations++;
+      std::fill(pinned.begin(), pinned.end(), false);
+      any_pinned = false;
+      complete = true;
+      return m_gradient.value_and_gradient(f, params);
+    };
+    auto free_gradient = [&]() {
+      if constexpr (requires { m_gradient.value_and_gradient(f, params, pinned); }) {
+        if (any_pinned) {
+          num_gradient_evaluations++;
+          complete = false;
+          return m_gradient.value_and_gradient(f, params, pinned);
+        }
+      }
+      return complete_gradient();
+    };
+    pin();
+    T grad_norm{current.gradient.norm()}; // initial projected |∇f|
+
+    // trial point P(x + α d) along the projected path, and φ'(α) from one Dual pass
+    // seeded with d on the coordinates that are not clamped. An f that does not
+    // accept Dual<T> (e.g. Var<T> only, for ReverseGradient) takes one backend pass
+    // instead, with φ'(α) = ∇f · d over the same coordinates
+    Vector<T, N> direction{params}, trial{params};
+    Vector<Dual<T>, N> seeds{};
+    if constexpr (N == std::dynamic_extent)
+      seeds = Vector<Dual<T>, N>(n);
+    auto phi = [&](T alpha) {
+      num_function_evaluations++;
+      for (std::size_t i = 0; i < n; i++) {
+        const T x = params[i] + alpha * direction[i];
+        const T clamped = std::clamp(x, lower[i], upper[i]);
+        seeds[i] = Dual<T>(clamped, clamped == x ? direction[i] : T(0));
+      }
+      if constexpr (unpacked_invocable<Func, Dual<T>, N>) {
+        const auto result = invoke_unpacked(f, seeds);
+        return LineSample<T>{result.real(), result.dual()};
+      } else {
+        num_gradient_evaluations++;
+        for (std::size_t i = 0; i < n; i++)
+          trial[i] = seeds[i].real();
+        const FirstOrder<T, N> result{m_gradient.value_and_gradient(f, trial)};
+        T slope{0};
+        for (std::size_t i = 0; i < n; i++)
+          slope += result.gradient[i] * seeds[i].dual();
+        return LineSample<T>{result.value, slope};
+      }
+    };
+
     // main optimisation loop
-    // stop when |∇f| < tol or max iterations reached
-    while (grad_norm > m_grad_tol and num_iterations < m_max_iterations) {
+    // stop when the projected |∇f| < tol or max iterations reached
+    while (true) {
+      // the free variables have converged: check the pins against a complete gradient
+      if (grad_norm <= m_grad_tol and not complete) {
+        current = complete_gradient();
+        pin();
+        grad_norm = current.gradient.norm();
+        continue;
+      }
+      if (grad_norm <= m_grad_tol or num_iterations >= m_max_iterations)
+        break;
+
+      const std::size_t previous_function_evaluations = num_function_evaluations;
+      const Clock::time_point start_direction = now();
+
+      // steepest descent over the free variables; pinned entries of the gradient are
+      // zero, so the direction never moves a held variable, and when every variable
+      // is held the slope is zero and the minimisation stops on the bounds
+      direction = current.gradient * T(-1);
+      const T slope = -(grad_norm * grad_norm);
+      if (not(slope < T(0)))
+        break;
+
+      const Clock::time_point start_search = now();
+      const LineSearchStep<T> step =
+          m_line_search(phi, LineSample<T>{current.value, slope}, m_step);
+      if (not step.accepted)
+        break;
+      // counted once a step is taken, so the observer sees every counted iteration
       num_iterations++;
 
       // update params, perform clamping
-      for (std::size_t i = 0; i < N; i++) {
-        params[i] = std::clamp(params[i] - m_step * grad_vec[i], lower[i], upper[i]);
+      const Clock::time_point start_update = now();
+      for (std::size_t i = 0; i < n; i++) {
+        params[i] =
+            std::clamp(params[i] + step.step * direction[i], lower[i], upper[i]);
       }
 
-      // compute new gradient and its magnitude
-      grad_vec = gradient(f, params);
-      grad_norm = grad_vec.norm();
+      // compute new value, gradient and its projected magnitude
+      // a line search already evaluated f at the accepted step, but along d only:
+      // ∇f still takes a full gradient, whose passes give the value again for free
+      const Clock::time_point start_gradient = now();
+      current = free_gradient();
+      pin();
+      grad_norm = current.gradient.norm();
+      const Clock::time_point end = now();
 
-      if (grad_norm <= m_grad_tol or num_iterations >= m_max_iterations)
+      const IterationInfo<T> info{
+          num_iterations,
+          current.value,
+          grad_norm,
+          step.step,
+          num_function_evaluations - previous_function_evaluations,
+          (start_update - start_search) + (end - start_gradient),
+          (start_search - start_direction) + (start_gradient - start_update)};
+      if (not notify_observer(observer, info))
         break;
     }
 
-    // if |∇f| < tol, convergence; if num it >= max it, divergence
+    // if projected |∇f| < tol, convergence; if num it >= max it, divergence
     const bool converged = grad_norm <= m_grad_tol;
 
-    // evalute f(x1, x2, ..., xN)
-    // need to convert to duals first
-    T value = [&]<std::size_t... Indices>(std::index_sequence<Indices...>) {
-      return f(Dual<T>(params[Indices], T(0))...).real();
-    }(std::make_index_sequence<N>{});
-
     // return result info to the user
-    return Result<T, N>(params, value, grad_norm, num_iterations, converged);
+    // f(params) came with the last gradient, no extra evaluation is needed
+    return Result<T, N>(params,
+                        current.value,
+                        grad_norm,
+                        num_iterations,
+                        converged,
+                        num_function_evaluations,
+                        num_gradient_evaluations);
   }
 
   // unbounded minimisation, (-infty, infty)
-  template <std::size_t N, typename Func>
-  Result<T, N> minimise(Func f, const Vector<T, N> &start) {
-    Vector<T, N> lower{}, upper{};
-    for (std::size_t i = 0; i < N; i++) {
+  template <std::size_t N, typename Func, typename Observer = NoObserver>
+  constexpr Result<T, N>
+  minimise(Func f, const Vector<T, N> &start, Observer &&observer = Observer{}) {
+    Vector<T, N> lower{start}, upper{start};
+    for (std::size_t i = 0; i < start.size(); i++) {
       lower[i] = -std::numeric_limits<T>::max();
       upper[i] = std::numeric_limits<T>::max();
     }
-    return minimise(f, start, lower, upper);
+    return minimise(f, start, lower, upper, std::forward<Observer>(observer));
   }
 
   // unbounded minimisation from zero starting point
-  template <std::size_t N, typename Func>
-  Result<T, N> minimise_from_zero(Func f) {
-    return minimise(f, Vector<T, N>{});
+  template <std::size_t N, typename Func, typename Observer = NoObserver>
+  constexpr Result<T, N> minimise_from_zero(Func f, Observer &&observer = Observer{}) {
+    return minimise(f, Vector<T, N>{}, std::forward<Observer>(observer));
   }
 
   // bounded minimisation from zero starting point
-  template <std::size_t N, typename Func>
-  Result<T, N>
-  minimise_from_zero(Func f, const Vector<T, N> &lower, const Vector<T, N> &upper) {
-    return minimise(f, Vector<T, N>{}, lower, upper);
+  template <std::size_t N, typename Func, typename Observer = NoObserver>
+  constexpr Result<T, N> minimise_from_zero(Func f,
+                                            const Vector<T, N> &lower,
+                                            const Vector<T, N> &upper,
+                                            Observer &&observer = Observer{}) {
+    return minimise(f, Vector<T, N>{}, lower, upper, std::forward<Observer>(observer));
   }
 };
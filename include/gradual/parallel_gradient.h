@@ -0,0 +1,134 @@
+#pragma once
+
+#include "dual.h"
+#include "gradient.h"
+#include "multi_dual.h"
+#include "thread_pool.h"
+#include "vector.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+
+// Forward-mode gradient with the seed passes spread over a ThreadPool.
+//   - pass p seeds coordinates [p K, (p + 1) K), with a Dual<T> for K = 1 and a
+//     MultiDual<T, K> otherwise, exactly as gradient() and gradient<K>() do; the
+//     passes are independent, so each partial derivative is bit-identical to the
+//     serial one whatever the number of threads
+//   - f is shared by every thread and only called through a const reference, so it
+//     must be safe to call concurrently: no mutable captures, no shared scratch
+//   - pass 0 runs on the calling thread and is timed; when it took less than
+//     min_pass_time the other passes run serially too, since waking the pool would
+//     cost more than it saves on cheap objectives
+//   - called from a ThreadPool body (e.g. inside minimise_multistart), the passes
+//     run serially on that thread
+
+struct ParallelGradientOptions {
+  ThreadPool *pool{nullptr}; // default_thread_pool() if null
+  std::chrono::nanoseconds min_pass_time{std::chrono::microseconds(50)};
+};
+
+// seed of one coordinate: tangent lane `lane` set to 1, none if lane >= K
+template <typename T, std::size_t K>
+constexpr auto make_seed(T x, std::size_t lane) {
+  if constexpr (K == 1) {
+    return Dual<T>(x, lane == 0 ? T(1) : T(0));
+  } else {
+    std::array<T, K> lanes{};
+    if (lane < K)
+      lanes[lane] = T(1);
+    return MultiDual<T, K>(x, lanes);
+  }
+}
+
+// f and ∇f, ceil(n / K) passes of f shared between the threads of the pool
+template <std::size_t K = 1, typename T, std::size_t N, typename Func>
+  requires(K > 0)
+FirstOrder<T, N>
+parallel_value_and_gradient(const Func &f,
+                            const Vector<T, N> &point,
+                            const ParallelGradientOptions &options = {}) {
+  using Seed = decltype(make_seed<T, K>(T(0), 0));
+  const std::size_t n = point.size();
+  const std::size_t num_passes = (n + K - 1) / K;
+
+  FirstOrder<T, N> result{T(0), point};
+
+  // runs passes [first, last) with one seed vector, re-seeding between passes
+  auto run_passes = [&](std::size_t first, std::size_t last) {
+    Vector<Seed, N> seeds{};
+    if constexpr (N == std::dynamic_extent)
+      seeds = Vector<Seed, N>(n);
+    for (std::size_t j = 0; j < n; j++)
+      seeds[j] = make_seed<T, K>(point[j], K);
+
+    for (std::size_t pass = first; pass < last; pass++) {
+      const std::size_t offset = pass * K, end = std::min(offset + K, n);
+      for (std::size_t j = offset; j < end; j++)
+        seeds[j] = make_seed<T, K>(point[j], j - offset);
+
+      const Seed partials = invoke_unpacked(f, seeds);
+      if (pass == 0)
+        result.value = partials.real();
+      for (std::size_t j = offset; j < end; j++) {
+        if constexpr (K == 1)
+          result.gradient[j] = partials.dual();
+        else
+          result.gradient[j] = partials.dual(j - offset);
+        seeds[j] = make_seed<T, K>(point[j], K);
+      }
+    }
+  };
+
+  if (n == 0)
+    return result;
+
+  const auto start = std::chrono::steady_clock::now();
+  run_passes(0, 1);
+  const auto pass_time = std::chrono::steady_clock::now() - start;
+
+  ThreadPool &pool = options.pool != nullptr ? *options.pool : default_thread_pool();
+  const std::size_t remaining = num_passes - 1;
+  if (remaining == 0)
+    return result;
+  if (pass_time < options.min_pass_time or pool.size() == 1) {
+    run_passes(1, num_passes);
+    return result;
+  }
+
+  // a few blocks of consecutive passes per thread: enough to balance the load,
+  // few enough that each block amortises its seed vector
+  const std::size_t num_blocks = std::min(remaining, 4 * pool.size());
+  pool.parallel_for(num_blocks, [&](std::size_t block) {
+    run_passes(1 + remaining * block / num_blocks,
+               1 + remaining * (block + 1) / num_blocks);
+  });
+
+  return result;
+}
+
+template <std::size_t K = 1, typename T, std::size_t N, typename Func>
+  requires(K > 0)
+Vector<T, N> parallel_gradient(const Func &f,
+                               const Vector<T, N> &point,
+                               const ParallelGradientOptions &options = {}) {
+  return parallel_value_and_gradient<K>(f, point, options).gradient;
+}
+
+// Gradient backend for Optimiser, opt-in: f must be safe to call concurrently
+// f must accept Dual<T> arguments for K = 1, MultiDual<T, K> otherwise
+template <std::size_t K = 1>
+  requires(K > 0)
+struct ParallelGradient {
+  ParallelGradientOptions options{};
+
+  template <typename T, std::size_t N, typename Func>
+  Vector<T, N> operator()(const Func &f, const Vector<T, N> &point) const {
+    return parallel_gradient<K>(f, point, options);
+  }
+
+  template <typename T, std::size_t N, typename Func>
+  FirstOrder<T, N> value_and_gradient(const Func &f, const Vector<T, N> &point) const {
+    return parallel_value_and_gradient<K>(f, point, options);
+  }
+};
@@ -0,0 +1,449 @@
+#pragma once
+
+#include "arena.h"
+#include "gradient.h"
+#include "vector.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <utility>
+
+// Reverse-mode automatic differentiation.
+// Evaluating f on Var<T> arguments records every elementary operation onto a Tape,
+// then a single backward sweep over the tape yields all N partial derivatives.
+// One evaluation of f per gradient, independently of N, at the cost of tape memory.
+
+// Tape node: an elementary operation with up to two operands
+//   - lhs, rhs are the tape indices of the operands
+//   - d_lhs, d_rhs are the local partial derivatives w.r.t. each operand
+// Leaves (independent variables) and unary operations carry zero partials
+// on the unused operand(s).
+template <typename T>
+struct TapeNode {
+  std::size_t lhs;
+  std::size_t rhs;
+  T d_lhs;
+  T d_rhs;
+};
+
+// Tape memory comes from an Arena: nodes live in fixed-size pages, and the page table
+// and adjoints are arena arrays too. Rewinding the arena between recordings therefore
+// reuses the same memory, and once a recording of a given size has been made, later
+// recordings of up to that size make no heap allocation.
+template <typename T>
+  requires std::floating_point<T>
+class Tape {
+private:
+  static constexpr std::size_t page_bits = 10;
+  static constexpr std::size_t page_size = std::size_t(1) << page_bits;
+
+  Arena m_local;  // used when no external arena is given
+  Arena *m_arena; // memory for pages, page table and adjoints
+  TapeNode<T> **m_pages{nullptr};
+  std::size_t m_num_pages{0};
+  std::size_t m_page_capacity{0};
+  std::size_t m_size{0};
+  T *m_adjoints{nullptr};
+
+  TapeNode<T> &node(std::size_t index) {
+    return m_pages[index >> page_bits][index & (page_size - 1)];
+  }
+
+  std::size_t push_node(const TapeNode<T> &node) {
+    if (m_size == m_num_pages * page_size) {
+      // grow the page table geometrically; the old table stays in the arena until
+      // the next rewind
+      if (m_num_pages == m_page_capacity) {
+        const std::size_t capacity = m_page_capacity == 0 ? 16 : 2 * m_page_capacity;
+        TapeNode<T> **pages = m_arena->allocate<TapeNode<T> *>(capacity);
+        std::copy(m_pages, m_pages + m_num_pages, pages);
+        m_pages = pages;
+        m_page_capacity = capacity;
+      }
+      m_pages[m_num_pages++] = m_arena->allocate<TapeNode<T>>(page_size);
+    }
+    this->node(m_size) = node;
+    return m_size++;
+  }
+
+public:
+  Tape() : m_arena(&m_local) {
+  }
+  // record onto an external arena, which must outlive the tape
+  explicit Tape(Arena &arena) : m_arena(&arena) {
+  }
+  // Vars point to their tape: tapes cannot be copied or moved
+  Tape(const Tape &) = delete;
+  Tape &operator=(const Tape &) = delete;
+
+  // record an independent variable, returns its index
+  std::size_t push_leaf() {
+    return this->push_node({m_size, m_size, T(0), T(0)});
+  }
+
+  // record a unary operation, returns its index
+  std::size_t push(std::size_t arg, T d_arg) {
+    return this->push_node({arg, arg, d_arg, T(0)});
+  }
+
+  // record a binary operation, returns its index
+  std::size_t push(std::size_t lhs, T d_lhs, std::size_t rhs, T d_rhs) {
+    return this->push_node({lhs, rhs, d_lhs, d_rhs});
+  }
+
+  // backward sweep: seed ∂output/∂output = 1 and accumulate adjoints
+  // adjoint(i) then holds ∂output/∂node_i
+  void propagate(std::size_t output) {
+    m_adjoints = m_arena->allocate<T>(m_size);
+    std::fill(m_adjoints, m_adjoints + m_size, T(0));
+    m_adjoints[output] = T(1);
+
+    for (std::size_t i = output + 1; i-- > 0;) {
+      const TapeNode<T> &node = this->node(i);
+      const T adjoint = m_adjoints[i];
+      m_adjoints[node.lhs] += node.d_lhs * adjoint;
+      m_adjoints[node.rhs] += node.d_rhs * adjoint;
+    }
+  }
+
+  [[nodiscard]] T adjoint(std::size_t index) const {
+    return m_adjoints[index];
+  }
+
+  // number of recorded nodes
+  [[nodiscard]] std::size_t size() const {
+    return m_size;
+  }
+
+  // forget all nodes and rewind the arena, keeping its memory for the next recording
+  void clear() {
+    m_pages = nullptr;
+    m_num_pages = 0;
+    m_page_capacity = 0;
+    m_size = 0;
+    m_adjoints = nullptr;
+    m_arena->rewind();
+  }
+};
+
+// Active scalar for reverse mode: a value plus its position on a tape.
+// A Var without a tape is a constant, operations with constants record no edge.
+template <typename T>
+  requires std::floating_point<T>
+class Var {
+private:
+  T m_value;
+  Tape<T> *m_tape;
+  std::size_t m_index;
+
+public:
+  using value_type = T;
+
+  // Constructor
+  constexpr Var() : m_value(T(0)), m_tape(nullptr), m_index(0) {
+  }
+  constexpr explicit Var(T value) : m_value(value), m_tape(nullptr), m_index(0) {
+  }
+  Var(T value, Tape<T> *tape, std::size_t index)
+      : m_value(value), m_tape(tape), m_index(index) {
+  }
+
+  // independent variable recorded on tape
+  static Var variable(T value, Tape<T> &tape) {
+    return Var(value, &tape, tape.push_leaf());
+  }
+
+  // Accessors
+  [[nodiscard]] constexpr T value() const {
+    return m_value;
+  }
+  [[nodiscard]] constexpr std::size_t index() const {
+    return m_index;
+  }
+  [[nodiscard]] constexpr Tape<T> *tape() const {
+    return m_tape;
+  }
+
+  // record g(this) given value = g(a) and derivative = g'(a)
+  [[nodiscard]] Var unary(T value, T derivative) const {
+    if (m_tape == nullptr)
+      return Var(value);
+    return Var(value, m_tape, m_tape->push(m_index, derivative));
+  }
+
+  // record g(this, other) given value and the partials w.r.t. each operand
+  [[nodiscard]] Var binary(const Var &other, T value, T d_this, T d_other) const {
+    if (other.m_tape == nullptr)
+      return this->unary(value, d_this);
+    if (m_tape == nullptr)
+      return other.unary(value, d_other);
+    return Var(value, m_tape, m_tape->push(m_index, d_this, other.m_index, d_other));
+  }
+
+  // Operator Overloads
+
+  // Var-Var binary ops
+  Var operator+(const Var &other) const {
+    return this->binary(other, m_value + other.m_value, T(1), T(1));
+  }
+
+  Var operator-(const Var &other) const {
+    return this->binary(other, m_value - other.m_value, T(1), T(-1));
+  }
+
+  Var operator*(const Var &other) const {
+    return this->binary(other, m_value * other.m_value, other.m_value, m_value);
+  }
+
+  Var operator/(const Var &other) const {
+    const T r = m_value / other.m_value;
+    return this->binary(other, r, T(1) / other.m_value, -r / other.m_value);
+  }
+
+  // Var-Scalar binary ops
+  Var operator+(const T &scalar) const {
+    return this->unary(m_value + scalar, T(1));
+  }
+
+  Var operator-(const T &scalar) const {
+    return this->unary(m_value - scalar, T(1));
+  }
+
+  Var operator*(const T &scalar) const {
+    return this->unary(m_value * scalar, scalar);
+  }
+
+  Var operator/(const T &scalar) const {
+    return this->unary(m_value / scalar, T(1) / scalar);
+  }
+
+  // Unary ops
+  Var operator-() const {
+    return this->unary(-m_value, T(-1));
+  }
+};
+
+// Scalar-Var binary ops (free functions)
+template <typename T>
+Var<T> operator+(const T &scalar, const Var<T> &x) {
+  return x + scalar;
+}
+
+template <typename T>
+Var<T> operator-(const T &scalar, const Var<T> &x) {
+  return x.unary(scalar - x.value(), T(-1));
+}
+
+template <typename T>
+Var<T> operator*(const T &scalar, const Var<T> &x) {
+  return x * scalar;
+}
+
+template <typename T>
+Var<T> operator/(const T &scalar, const Var<T> &x) {
+  const T r = scalar / x.value();
+  return x.unary(r, -r / x.value());
+}
+
+// Integer-Var binary ops (allows operations like 1 + x where x is Var)
+template <typename T, std::integral I>
+Var<T> operator+(I scalar, const Var<T> &x) {
+  return T(scalar) + x;
+}
+
+template <typename T, std::integral I>
+Var<T> operator-(I scalar, const Var<T> &x) {
+  return T(scalar) - x;
+}
+
+template <typename T, std::integral I>
+Var<T> operator*(I scalar, const Var<T> &x) {
+  return T(scalar) * x;
+}
+
+template <typename T, std::integral I>
+Var<T> operator/(I scalar, const Var<T> &x) {
+  return T(scalar) / x;
+}
+
+// Elementary operations
+// Same derivative rules as for Dual<T>; the local derivative is stored on the tape
+
+template <typename T>
+Var<T> sqrt(const Var<T> &x) {
+  const T r = std::sqrt(x.value());
+  return x.unary(r, T(1) / (T(2) * r));
+}
+
+template <typename T>
+Var<T> pow(const Var<T> &x, const T &n) {
+  const T a = x.value();
+  return x.unary(std::pow(a, n), n * std::pow(a, n - T(1)));
+}
+
+// Overload for integer exponents (allows pow(x, 2) instead of pow(x, 2.0))
+template <typename T, std::integral I>
+Var<T> pow(const Var<T> &x, I n) {
+  return pow(x, T(n));
+}
+
+template <typename T>
+Var<T> exp(const Var<T> &x) {
+  const T r = std::exp(x.value());
+  return x.unary(r, r);
+}
+
+template <typename T>
+Var<T> log(const Var<T> &x) {
+  return x.unary(std::log(x.value()), T(1) / x.value());
+}
+
+template <typename T>
+Var<T> sin(const Var<T> &x) {
+  return x.unary(std::sin(x.value()), std::cos(x.value()));
+}
+
+template <typename T>
+Var<T> cos(const Var<T> &x) {
+  return x.unary(std::cos(x.value()), -std::sin(x.value()));
+}
+
+template <typename T>
+Var<T> tan(const Var<T> &x) {
+  const T r = std::tan(x.value());
+  return x.unary(r, T(1) + r * r);
+}
+
+// reverse-mode value and gradient recorded onto an external arena
+//   - the arena is rewound first, so repeated calls reuse the same memory
+//   - f is called once with Var<T> arguments, recording the tape
+//   - the recorded output is f; one backward sweep gives ∂f/∂x_i for every i
+// num_nodes, if given, receives the size of the recorded tape
+template <typename T, std::size_t N, typename Func>
+FirstOrder<T, N> reverse_value_and_gradient(Func f,
+                                            const Vector<T, N> &point,
+                                            Arena &arena,
+                                            std::size_t *num_nodes = nullptr) {
+  arena.rewind();
+  Tape<T> tape(arena);
+
+  std::array<Var<T>, N> vars;
+  for (std::size_t i = 0; i < N; i++)
+    vars[i] = Var<T>::variable(point[i], tape);
+
+  Var<T> output = [&]<std::size_t... Indices>(std::index_sequence<Indices...>) {
+    return f(vars[Indices]...);
+  }(std::make_index_sequence<N>{});
+
+  if (num_nodes != nullptr)
+    *num_nodes = tape.size();
+
+  FirstOrder<T, N> result{output.value(), Vector<T, N>{}};
+  // f does not depend on its arguments: zero gradient
+  if (output.tape() == nullptr)
+    return result;
+
+  tape.propagate(output.index());
+  for (std::size_t i = 0; i < N; i++)
+    result.gradient[i] = tape.adjoint(vars[i].index());
+
+  return result;
+}
+
+// reverse-mode value and gradient for a runtime-size point
+// f takes a std::span<const Var<T>>; the variables are stored in the arena, next to
+// the tape, so a rewound arena makes repeated calls allocation-free
+template <typename T, typename Func>
+FirstOrder<T, std::dynamic_extent>
+reverse_value_and_gradient(Func f,
+                           const DynamicVector<T> &point,
+                           Arena &arena,
+                           std::size_t *num_nodes = nullptr) {
+  arena.rewind();
+  Tape<T> tape(arena);
+
+  const std::size_t n = point.size();
+  Var<T> *vars = arena.allocate<Var<T>>(n);
+  for (std::size_t i = 0; i < n; i++)
+    std::construct_at(vars + i, Var<T>::variable(point[i], tape));
+
+  Var<T> output = f(std::span<const Var<T>>(vars, n));
+
+  if (num_nodes != nullptr)
+    *num_nodes = tape.size();
+
+  FirstOrder<T, std::dynamic_extent> result{output.value(), DynamicVector<T>(n)};
+  // f does not depend on its arguments: zero gradient
+  if (output.tape() == nullptr)
+    return result;
+
+  tape.propagate(output.index());
+  for (std::size_t i = 0; i < n; i++)
+    result.gradient[i] = tape.adjoint(vars[i].index());
+
+  return result;
+}
+
+// reverse-mode gradient recorded onto an external arena, see above
+template <typename T, std::size_t N, typename Func>
+Vector<T, N> reverse_gradient(Func f,
+                              const Vector<T, N> &point,
+                              Arena &arena,
+                              std::size_t *num_nodes = nullptr) {
+  return reverse_value_and_gradient(f, point, arena, num_nodes).gradient;
+}
+
+// reverse-mode gradient, same calling convention as gradient()
+// uses a fresh arena; prefer the overload above (or ReverseGradient) when called
+// repeatedly
+template <typename T, std::size_t N, typename Func>
+Vector<T, N> reverse_gradient(Func f, const Vector<T, N> &point) {
+  Arena arena;
+  return reverse_value_and_gradient(f, point, arena).gradient;
+}
+
+// Tape memory statistics reported by ReverseGradient
+struct TapeStats {
+  std::size_t peak_bytes;       // largest arena footprint of a recording
+  std::size_t node_count;       // nodes recorded by the last gradient
+  std::size_t peak_node_count;  // largest recording so far
+  std::size_t reuse_count;      // recordings served from previously allocated memory
+  std::size_t heap_allocations; // arena blocks requested from the heap
+};
+
+// Gradient backend for Optimiser: reverse mode, one evaluation of f per gradient
+// f must accept Var<T> arguments, e.g. a generic lambda
+// The tape arena is kept across calls: after the first iteration of minimise, the
+// steady state makes no heap allocation.
+class ReverseGradient {
+private:
+  Arena m_arena;
+  std::size_t m_node_count{0};
+  std::size_t m_peak_node_count{0};
+
+public:
+  template <typename T, std::size_t N, typename Func>
+  Vector<T, N> operator()(Func f, const Vector<T, N> &point) {
+    return value_and_gradient(f, point).gradient;
+  }
+
+  template <typename T, std::size_t N, typename Func>
+  FirstOrder<T, N> value_and_gradient(Func f, const Vector<T, N> &point) {
+    FirstOrder<T, N> result =
+        reverse_value_and_gradient(f, point, m_arena, &m_node_count);
+    m_peak_node_count = std::max(m_peak_node_count, m_node_count);
+    return result;
+  }
+
+  [[nodiscard]] TapeStats stats() const {
+    return {m_arena.peak_bytes(),
+            m_node_count,
+            m_peak_node_count,
+            m_arena.reuse_count(),
+            m_arena.heap_allocations()};
+  }
+};
@@ -0,0 +1,659 @@
+#pragma once
+
+#include "constexpr_math.h"
+#include "dual.h"
+#include "gradient.h"
+#include "lanes.h"
+#include "matrix.h"
+#include "vector.h"
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <concepts>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Sparse Jacobians and Hessians by seed compression.
+//   - a tracing pass evaluates f once on SparsityTracer<T, N> arguments, which carry
+//     the set of inputs each value depends on: the dependencies of each output are the
+//     non-zero columns of its Jacobian row, and every product or nonlinear function
+//     of the inputs marks the second derivatives it may create
+//   - columns that share no row are structurally orthogonal and get the same colour;
+//     a single pass seeded with the sum of the columns of a colour recovers each of
+//     them, since every row holds at most one of them
+// A Jacobian then costs one Dual<T> pass per colour instead of N, and a Hessian one
+// HessianLanes<T, N> pass per colour instead of N(N+1)/2 hyper-dual passes. Separable
+// or banded objectives need a handful of colours whatever N.
+// The pattern is detected at a point, with the real values carried along: it holds
+// elsewhere unless f branches on its arguments, in which case detect it again.
+
+// pairs of inputs (i, j) whose second derivative ∂²f/∂x_i∂x_j may be non-zero
+template <std::size_t N>
+class InteractionRecorder {
+private:
+  std::vector<std::bitset<N>> m_rows = std::vector<std::bitset<N>>(N);
+
+public:
+  // every input of a interacts with every input of b
+  void add(const std::bitset<N> &a, const std::bitset<N> &b) {
+    for (std::size_t i = 0; i < N; i++) {
+      if (a[i])
+        m_rows[i] |= b;
+      if (b[i])
+        m_rows[i] |= a;
+    }
+  }
+
+  const std::bitset<N> &row(std::size_t i) const {
+    return m_rows[i];
+  }
+};
+
+// Value of f together with the inputs it depends on, for sparsity detection.
+// Sums take the union of the dependencies; products, quotients and elementary
+// functions also record the interactions they create, when traced for a Hessian.
+template <typename T, std::size_t N>
+  requires std::floating_point<T>
+class SparsityTracer {
+private:
+  T m_real;
+  std::bitset<N> m_dependencies;
+  InteractionRecorder<N> *m_recorder;
+
+  constexpr InteractionRecorder<N> *recorder(const SparsityTracer &other) const {
+    return m_recorder != nullptr ? m_recorder : other.m_recorder;
+  }
+
+  void record(InteractionRecorder<N> *recorder,
+              const std::bitset<N> &a,
+              const std::bitset<N> &b) const {
+    if (recorder != nullptr and a.any() and b.any())
+      recorder->add(a, b);
+  }
+
+public:
+  // Public type alias to support concept detection in Vector
+  using value_type = T;
+
+  // Constructor
+  constexpr SparsityTracer() : m_real(T(0)), m_dependencies{}, m_recorder(nullptr) {
+  }
+  SparsityTracer(T real,
+                 const std::bitset<N> &dependencies,
+                 InteractionRecorder<N> *recorder)
+      : m_real(real), m_dependencies(dependencies), m_recorder(recorder) {
+  }
+
+  // Accessors
+  [[nodiscard]] constexpr T real() const {
+    return m_real;
+  }
+  [[nodiscard]] const std::bitset<N> &dependencies() const {
+    return m_dependencies;
+  }
+
+  // Operator Overloads
+
+  // SparsityTracer-SparsityTracer binary ops
+  SparsityTracer operator+(const SparsityTracer &other) const {
+    return {m_real + other.m_real,
+            m_dependencies | other.m_dependencies,
+            recorder(other)};
+  }
+
+  SparsityTracer operator-(const SparsityTracer &other) const {
+    return {m_real - other.m_real,
+            m_dependencies | other.m_dependencies,
+            recorder(other)};
+  }
+
+  SparsityTracer operator*(const SparsityTracer &other) const {
+    record(recorder(other), m_dependencies, other.m_dependencies);
+    return {m_real * other.m_real,
+            m_dependencies | other.m_dependencies,
+            recorder(other)};
+  }
+
+  SparsityTracer operator/(const SparsityTracer &other) const {
+    record(recorder(other), m_dependencies, other.m_dependencies);
+    record(recorder(other), other.m_dependencies, other.m_dependencies);
+    return {m_real / other.m_real,
+            m_dependencies | other.m_dependencies,
+            recorder(other)};
+  }
+
+  // SparsityTracer-Scalar binary ops
+  SparsityTracer operator+(const T &scalar) const {
+    return {m_real + scalar, m_dependencies, m_recorder};
+  }
+
+  SparsityTracer operator-(const T &scalar) const {
+    return {m_real - scalar, m_dependencies, m_recorder};
+  }
+
+  SparsityTracer operator*(const T &scalar) const {
+    return {m_real * scalar, m_dependencies, m_recorder};
+  }
+
+  SparsityTracer operator/(const T &scalar) const {
+    return {m_real / scalar, m_dependencies, m_recorder};
+  }
+
+  // Unary ops
+  SparsityTracer operator-() const {
+    return {-m_real, m_dependencies, m_recorder};
+  }
+
+  // nonlinear elementary function g, given value = g(a): every input interacts with
+  // every other one
+  [[nodiscard]] SparsityTracer nonlinear(T value) const {
+    record(m_recorder, m_dependencies, m_dependencies);
+    return {value, m_dependencies, m_recorder};
+  }
+};
+
+// Scalar-SparsityTracer binary ops (free functions)
+template <typename T, std::size_t N>
+SparsityTracer<T, N> operator+(const T &scalar, const SparsityTracer<T, N> &x) {
+  return x + scalar;
+}
+
+template <typename T, std::size_t N>
+SparsityTracer<T, N> operator-(const T &scalar, const SparsityTracer<T, N> &x) {
+  return -x + scalar;
+}
+
+template <typename T, std::size_t N>
+SparsityTracer<T, N> operator*(const T &scalar, const SparsityTracer<T, N> &x) {
+  return x * scalar;
+}
+
+template <typename T, std::size_t N>
+SparsityTracer<T, N> operator/(const T &scalar, const SparsityTracer<T, N> &x) {
+  return x.nonlinear(scalar / x.real());
+}
+
+// Integer-SparsityTracer binary ops (allows operations like 1 + x)
+template <typename T, std::size_t N, std::integral I>
+SparsityTracer<T, N> operator+(I scalar, const SparsityTracer<T, N> &x) {
+  return T(scalar) + x;
+}
+
+template <typename T, std::size_t N, std::integral I>
+SparsityTracer<T, N> operator-(I scalar, const SparsityTracer<T, N> &x) {
+  return T(scalar) - x;
+}
+
+template <typename T, std::size_t N, std::integral I>
+SparsityTracer<T, N> operator*(I scalar, const SparsityTracer<T, N> &x) {
+  return T(scalar) * x;
+}
+
+template <typename T, std::size_t N, std::integral I>
+SparsityTracer<T, N> operator/(I scalar, const SparsityTracer<T, N> &x) {
+  return T(scalar) / x;
+}
+
+// Elementary operations, all nonlinear in their argument
+// The values go through constexpr_math, as for the other dual types; the tracer itself
+// is not constexpr, since std::bitset is not before C++23
+
+template <typename T, std::size_t N>
+SparsityTracer<T, N> sqrt(const SparsityTracer<T, N> &x) {
+  return x.nonlinear(constexpr_math::sqrt(x.real()));
+}
+
+template <typename T, std::size_t N>
+SparsityTracer<T, N> pow(const SparsityTracer<T, N> &x, const T &n) {
+  return x.nonlinear(constexpr_math::pow(x.real(), n));
+}
+
+template <typename T, std::size_t N, std::integral I>
+SparsityTracer<T, N> pow(const SparsityTracer<T, N> &x, I n) {
+  return pow(x, T(n));
+}
+
+template <typename T, std::size_t N>
+SparsityTracer<T, N> exp(const SparsityTracer<T, N> &x) {
+  return x.nonlinear(constexpr_math::exp(x.real()));
+}
+
+template <typename T, std::size_t N>
+SparsityTracer<T, N> log(const SparsityTracer<T, N> &x) {
+  return x.nonlinear(constexpr_math::log(x.real()));
+}
+
+template <typename T, std::size_t N>
+SparsityTracer<T, N> sin(const SparsityTracer<T, N> &x) {
+  return x.nonlinear(constexpr_math::sin(x.real()));
+}
+
+template <typename T, std::size_t N>
+SparsityTracer<T, N> cos(const SparsityTracer<T, N> &x) {
+  return x.nonlinear(constexpr_math::cos(x.real()));
+}
+
+template <typename T, std::size_t N>
+SparsityTracer<T, N> tan(const SparsityTracer<T, N> &x) {
+  return x.nonlinear(constexpr_math::tan(x.real()));
+}
+
+// Structurally non-zero entries of a rows × cols matrix, by row in increasing column
+class SparsityPattern {
+private:
+  std::size_t m_cols{};
+  std::vector<std::vector<std::size_t>> m_rows;
+
+public:
+  SparsityPattern(std::size_t rows, std::size_t cols) : m_cols(cols), m_rows(rows) {
+  }
+
+  std::size_t rows() const {
+    return m_rows.size();
+  }
+  std::size_t cols() const {
+    return m_cols;
+  }
+
+  // columns of the non-zero entries of row i
+  const std::vector<std::size_t> &row(std::size_t i) const {
+    return m_rows[i];
+  }
+
+  bool contains(std::size_t i, std::size_t j) const {
+    return std::binary_search(m_rows[i].begin(), m_rows[i].end(), j);
+  }
+
+  std::size_t num_nonzeros() const {
+    std::size_t count{0};
+    for (const auto &row : m_rows)
+      count += row.size();
+    return count;
+  }
+
+  // columns must be added in increasing order within a row
+  void add(std::size_t i, std::size_t j) {
+    m_rows[i].push_back(j);
+  }
+};
+
+// colour of each column, columns of the same colour share no row
+struct SeedColouring {
+  std::size_t num_colours{};
+  std::vector<std::size_t> colours;
+};
+
+// greedy colouring of the columns in their natural order, each column taking the
+// smallest colour not used by a column it shares a row with; banded patterns of
+// half-bandwidth b get 2b + 1 colours, diagonal ones a single colour
+inline SeedColouring colour_columns(const SparsityPattern &pattern) {
+  const std::size_t n = pattern.cols();
+  std::vector<std::vector<std::size_t>> rows_of_column(n);
+  for (std::size_t i = 0; i < pattern.rows(); i++)
+    for (std::size_t j : pattern.row(i))
+      rows_of_column[j].push_back(i);
+
+  SeedColouring result{0, std::vector<std::size_t>(n, 0)};
+  // forbidden[c] == j + 1 when colour c is taken by a neighbour of column j
+  std::vector<std::size_t> forbidden(n + 1, 0);
+  for (std::size_t j = 0; j < n; j++) {
+    for (std::size_t i : rows_of_column[j])
+      for (std::size_t k : pattern.row(i))
+        if (k < j)
+          forbidden[result.colours[k]] = j + 1;
+
+    std::size_t colour{0};
+    while (forbidden[colour] == j + 1)
+      colour++;
+    result.colours[j] = colour;
+    result.num_colours = std::max(result.num_colours, colour + 1);
+  }
+
+  return result;
+}
+
+// tracer arguments for point, input j depending on itself only
+template <typename T, std::size_t N>
+Vector<SparsityTracer<T, N>, N> make_tracers(const Vector<T, N> &point,
+                                             InteractionRecorder<N> *recorder) {
+  Vector<SparsityTracer<T, N>, N> tracers{};
+  for (std::size_t j = 0; j < N; j++) {
+    std::bitset<N> self{};
+    self.set(j);
+    tracers[j] = SparsityTracer<T, N>(point[j], self, recorder);
+  }
+  return tracers;
+}
+
+// M × N Jacobian pattern of a vector-valued f, as for value_and_jacobian
+template <typename T, std::size_t N, typename Func>
+SparsityPattern jacobian_sparsity(Func f, const Vector<T, N> &point) {
+  const auto tracers = make_tracers<T, N>(point, nullptr);
+  const auto outputs = invoke_unpacked(f, tracers);
+
+  SparsityPattern pattern(outputs.size(), N);
+  for (std::size_t i = 0; i < outputs.size(); i++)
+    for (std::size_t j = 0; j < N; j++)
+      if (outputs[i].dependencies()[j])
+        pattern.add(i, j);
+  return pattern;
+}
+
+// N × N Hessian pattern of a scalar f; conservative, an interaction created by an
+// intermediate that does not reach the output is kept
+template <typename T, std::size_t N, typename Func>
+SparsityPattern hessian_sparsity(Func f, const Vector<T, N> &point) {
+  InteractionRecorder<N> recorder;
+  const auto tracers = make_tracers<T, N>(point, &recorder);
+  invoke_unpacked(f, tracers);
+
+  SparsityPattern pattern(N, N);
+  for (std::size_t i = 0; i < N; i++)
+    for (std::size_t j = 0; j < N; j++)
+      if (recorder.row(i)[j])
+        pattern.add(i, j);
+  return pattern;
+}
+
+// pattern and colouring, detected once and reused at every evaluation
+struct SparseSeeds {
+  SparsityPattern pattern;
+  SeedColouring colouring;
+};
+
+template <typename T, std::size_t N, typename Func>
+SparseSeeds sparse_jacobian_seeds(Func f, const Vector<T, N> &point) {
+  SparsityPattern pattern = jacobian_sparsity(f, point);
+  SeedColouring colouring = colour_columns(pattern);
+  return {std::move(pattern), std::move(colouring)};
+}
+
+template <typename T, std::size_t N, typename Func>
+SparseSeeds sparse_hessian_seeds(Func f, const Vector<T, N> &point) {
+  SparsityPattern pattern = hessian_sparsity(f, point);
+  SeedColouring colouring = colour_columns(pattern);
+  return {std::move(pattern), std::move(colouring)};
+}
+
+// r and its Jacobian from one Dual<T> pass per colour
+// pass c seeds every x_j of colour c, so the dual part of r_i is ∂r_i/∂x_j for the
+// only such j in row i
+template <typename T, std::size_t N, typename Func>
+auto value_and_jacobian(Func f, const Vector<T, N> &point, const SparseSeeds &seeds) {
+  using Outputs = decltype(invoke_unpacked(f, std::declval<Vector<Dual<T>, N> &>()));
+  constexpr std::size_t M = Outputs::extent;
+  ResidualsAndJacobian<T, M, N> result{};
+  const std::vector<std::size_t> &colours = seeds.colouring.colours;
+
+  Vector<Dual<T>, N> duals{};
+  const std::size_t num_passes = std::max<std::size_t>(seeds.colouring.num_colours, 1);
+  for (std::size_t colour = 0; colour < num_passes; colour++) {
+    for (std::size_t j = 0; j < N; j++)
+      duals[j] = Dual<T>(point[j], colours[j] == colour ? T(1) : T(0));
+    const Outputs outputs = invoke_unpacked(f, duals);
+    for (std::size_t i = 0; i < M; i++) {
+      result.residuals[i] = outputs[i].real();
+      for (std::size_t j : seeds.pattern.row(i))
+        if (colours[j] == colour)
+          result.jacobian(i, j) = outputs[i].dual();
+    }
+  }
+
+  return result;
+}
+
+template <typename T, std::size_t N, typename Func>
+auto jacobian(Func f, const Vector<T, N> &point, const SparseSeeds &seeds) {
+  return value_and_jacobian(f, point, seeds).jacobian;
+}
+
+// Values of the form a + Σ_k b_k ε_k + c δ + Σ_k d_k ε_k δ, with ε_k ε_l = δ² = 0.
+// Seeding ε_k = e_k and δ = s gives f, ∇f, ∇f·s and the Hessian product H s in one
+// evaluation; the N gradient lanes and N product lanes are updated by the Lanes
+// kernels, as for MultiDual.
+template <typename T, std::size_t N>
+  requires std::floating_point<T>
+class HessianLanes {
+private:
+  T m_real;
+  Lanes<T, N> m_gradient;
+  T m_direction;
+  Lanes<T, N> m_product;
+
+  constexpr HessianLanes(T real,
+                         const Lanes<T, N> &gradient,
+                         T direction,
+                         const Lanes<T, N> &product)
+      : m_real(real), m_gradient(gradient), m_direction(direction), m_product(product) {
+  }
+
+public:
+  // Public type alias to support concept detection in Vector
+  using value_type = T;
+
+  // Constructor
+  constexpr HessianLanes()
+      : m_real(T(0)), m_gradient{}, m_direction(T(0)), m_product{} {
+  }
+  // input x_j, seeded with e_j and the direction component s_j
+  constexpr HessianLanes(T real, std::size_t index, T direction)
+      : m_real(real), m_gradient{}, m_direction(direction), m_product{} {
+    m_gradient[index] = T(1);
+  }
+
+  // Accessors
+  [[nodiscard]] constexpr T real() const {
+    return m_real;
+  }
+  // ∂f/∂x_k
+  [[nodiscard]] constexpr T dual(std::size_t lane) const {
+    return m_gradient[lane];
+  }
+  // ∇f·s
+  [[nodiscard]] constexpr T direction() const {
+    return m_direction;
+  }
+  // (H s)_k
+  [[nodiscard]] constexpr T product(std::size_t lane) const {
+    return m_product[lane];
+  }
+
+  // Operator Overloads
+
+  // HessianLanes-HessianLanes binary ops
+  constexpr HessianLanes operator+(const HessianLanes &other) const {
+    return HessianLanes(m_real + other.m_real,
+                        Lanes<T, N>::add(m_gradient, other.m_gradient),
+                        m_direction + other.m_direction,
+                        Lanes<T, N>::add(m_product, other.m_product));
+  }
+
+  constexpr HessianLanes operator-(const HessianLanes &other) const {
+    return HessianLanes(m_real - other.m_real,
+                        Lanes<T, N>::sub(m_gradient, other.m_gradient),
+                        m_direction - other.m_direction,
+                        Lanes<T, N>::sub(m_product, other.m_product));
+  }
+
+  // d = a₂ d₁ + a₁ d₂ + c₂ b₁ + c₁ b₂
+  constexpr HessianLanes operator*(const HessianLanes &other) const {
+    return HessianLanes(
+        m_real * other.m_real,
+        Lanes<T, N>::axpby(other.m_real, m_gradient, m_real, other.m_gradient),
+        other.m_real * m_direction + m_real * other.m_direction,
+        Lanes<T, N>::add(
+            Lanes<T, N>::axpby(other.m_real, m_product, m_real, other.m_product),
+            Lanes<T, N>::axpby(
+                other.m_direction, m_gradient, m_direction, other.m_gradient)));
+  }
+
+  // x / y = x · (1/y), with 1/y expanded through the chain rule
+  constexpr HessianLanes operator/(const HessianLanes &other) const {
+    const T inv = T(1) / other.m_real;
+    return *this * other.chain(inv, -inv * inv, T(2) * inv * inv * inv);
+  }
+
+  // HessianLanes-Scalar binary ops
+  constexpr HessianLanes operator+(const T &scalar) const {
+    return HessianLanes(m_real + scalar, m_gradient, m_direction, m_product);
+  }
+
+  constexpr HessianLanes operator-(const T &scalar) const {
+    return HessianLanes(m_real - scalar, m_gradient, m_direction, m_product);
+  }
+
+  constexpr HessianLanes operator*(const T &scalar) const {
+    return chain(m_real * scalar, scalar, T(0));
+  }
+
+  constexpr HessianLanes operator/(const T &scalar) const {
+    return chain(m_real / scalar, T(1) / scalar, T(0));
+  }
+
+  // Unary ops
+  constexpr HessianLanes operator-() const {
+    return chain(-m_real, T(-1), T(0));
+  }
+
+  // second-order chain rule for an elementary function g, given value = g(a),
+  // first = g'(a) and second = g''(a):
+  //   g(a) + g'(a) b ε + g'(a) c δ + (g'(a) d + g''(a) c b) εδ
+  [[nodiscard]] constexpr HessianLanes chain(T value, T first, T second) const {
+    return HessianLanes(value,
+                        Lanes<T, N>::scale(first, m_gradient),
+                        first * m_direction,
+                        Lanes<T, N>::axpby(first, m_product, second * m_direction,
+                                           m_gradient));
+  }
+};
+
+// Scalar-HessianLanes binary ops (free functions)
+template <typename T, std::size_t N>
+constexpr HessianLanes<T, N> operator+(const T &scalar, const HessianLanes<T, N> &x) {
+  return x + scalar;
+}
+
+template <typename T, std::size_t N>
+constexpr HessianLanes<T, N> operator-(const T &scalar, const HessianLanes<T, N> &x) {
+  return -x + scalar;
+}
+
+template <typename T, std::size_t N>
+constexpr HessianLanes<T, N> operator*(const T &scalar, const HessianLanes<T, N> &x) {
+  return x * scalar;
+}
+
+template <typename T, std::size_t N>
+constexpr HessianLanes<T, N> operator/(const T &scalar, const HessianLanes<T, N> &x) {
+  const T inv = T(1) / x.real();
+  return x.chain(inv, -inv * inv, T(2) * inv * inv * inv) * scalar;
+}
+
+// Integer-HessianLanes binary ops (allows operations like 1 + x)
+template <typename T, std::size_t N, std::integral I>
+constexpr HessianLanes<T, N> operator+(I scalar, const HessianLanes<T, N> &x) {
+  return T(scalar) + x;
+}
+
+template <typename T, std::size_t N, std::integral I>
+constexpr HessianLanes<T, N> operator-(I scalar, const HessianLanes<T, N> &x) {
+  return T(scalar) - x;
+}
+
+template <typename T, std::size_t N, std::integral I>
+constexpr HessianLanes<T, N> operator*(I scalar, const HessianLanes<T, N> &x) {
+  return T(scalar) * x;
+}
+
+template <typename T, std::size_t N, std::integral I>
+constexpr HessianLanes<T, N> operator/(I scalar, const HessianLanes<T, N> &x) {
+  return T(scalar) / x;
+}
+
+// Elementary operations
+// Same derivative rules as for HyperDual<T>, through chain(g, g', g''), and constexpr
+// through constexpr_math in the same way
+
+template <typename T, std::size_t N>
+constexpr HessianLanes<T, N> sqrt(const HessianLanes<T, N> &x) {
+  const T r = constexpr_math::sqrt(x.real());
+  return x.chain(r, T(1) / (T(2) * r), -T(1) / (T(4) * r * x.real()));
+}
+
+template <typename T, std::size_t N>
+constexpr HessianLanes<T, N> pow(const HessianLanes<T, N> &x, const T &n) {
+  const T a = x.real();
+  return x.chain(constexpr_math::pow(a, n),
+                 n * constexpr_math::pow(a, n - T(1)),
+                 n * (n - T(1)) * constexpr_math::pow(a, n - T(2)));
+}
+
+template <typename T, std::size_t N, std::integral I>
+constexpr HessianLanes<T, N> pow(const HessianLanes<T, N> &x, I n) {
+  return pow(x, T(n));
+}
+
+template <typename T, std::size_t N>
+constexpr HessianLanes<T, N> exp(const HessianLanes<T, N> &x) {
+  const T r = constexpr_math::exp(x.real());
+  return x.chain(r, r, r);
+}
+
+template <typename T, std::size_t N>
+constexpr HessianLanes<T, N> log(const HessianLanes<T, N> &x) {
+  const T inv = T(1) / x.real();
+  return x.chain(constexpr_math::log(x.real()), inv, -inv * inv);
+}
+
+template <typename T, std::size_t N>
+constexpr HessianLanes<T, N> sin(const HessianLanes<T, N> &x) {
+  const T s = constexpr_math::sin(x.real());
+  return x.chain(s, constexpr_math::cos(x.real()), -s);
+}
+
+template <typename T, std::size_t N>
+constexpr HessianLanes<T, N> cos(const HessianLanes<T, N> &x) {
+  const T c = constexpr_math::cos(x.real());
+  return x.chain(c, -constexpr_math::sin(x.real()), -c);
+}
+
+template <typename T, std::size_t N>
+constexpr HessianLanes<T, N> tan(const HessianLanes<T, N> &x) {
+  const T r = constexpr_math::tan(x.real());
+  const T first = T(1) + r * r;
+  return x.chain(r, first, T(2) * r * first);
+}
+
+// f, ∇f and the Hessian from one HessianLanes<T, N> pass per colour
+// pass c seeds δ with every x_j of colour c, so (H s)_i is ∂²f/∂x_i∂x_j for the only
+// such j in row i; every pass also gives f and ∇f
+// f must accept HessianLanes<T, N> arguments, e.g. a generic lambda
+template <typename T, std::size_t N, typename Func>
+SecondOrder<T, N>
+value_gradient_hessian(Func f, const Vector<T, N> &point, const SparseSeeds &seeds) {
+  SecondOrder<T, N> result{};
+  const std::vector<std::size_t> &colours = seeds.colouring.colours;
+
+  Vector<HessianLanes<T, N>, N> args{};
+  const std::size_t num_passes = std::max<std::size_t>(seeds.colouring.num_colours, 1);
+  for (std::size_t colour = 0; colour < num_passes; colour++) {
+    for (std::size_t j = 0; j < N; j++)
+      args[j] = HessianLanes<T, N>(point[j], j, colours[j] == colour ? T(1) : T(0));
+    const HessianLanes<T, N> h = invoke_unpacked(f, args);
+    result.value = h.real();
+    for (std::size_t i = 0; i < N; i++) {
+      result.gradient[i] = h.dual(i);
+      for (std::size_t j : seeds.pattern.row(i))
+        if (colours[j] == colour)
+          result.hessian(i, j) = h.product(i);
+    }
+  }
+
+  return result;
+}
+
+template <typename T, std::size_t N, typename Func>
+Matrix<T, N, N> hessian(Func f, const Vector<T, N> &point, const SparseSeeds &seeds) {
+  return value_gradient_hessian(f, point, seeds).hessian;
+}
@@ -0,0 +1,266 @@
+#pragma once
+
+#include "constexpr_math.h"
+#include "gradient.h"
+#include "observer.h"
+#include "sum_over.h"
+#include "vector.h"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Mini-batch stochastic optimisation over a dataset of num_samples samples.
+// Each epoch shuffles the sample indices and visits them in batches of batch_size;
+// every batch takes one step along the gradient of the mean loss over the batch.
+//   - only the index permutation is shuffled, the samples themselves are never copied
+//   - the update rule keeps its state (velocity, moments) in Vector<T, N> buffers
+//     allocated once per minimisation
+//   - the shuffles come from a generator seeded with seed, so a run is reproducible
+// The loss takes the sample (or its index) first, then the parameters as for
+// Optimiser::minimise, so it can be differentiated by any gradient backend.
+
+// state of an update rule, allocated once per minimisation
+template <typename T, std::size_t N>
+struct UpdateState {
+  Vector<T, N> first;  // velocity or first moment
+  Vector<T, N> second; // second moment
+  std::size_t steps{0};
+};
+
+// Update rules, each applying one step to params given the batch gradient
+
+// plain stochastic gradient descent, x -= η g
+template <typename T>
+struct Sgd {
+  T learning_rate{T(0.01)};
+
+  template <std::size_t N>
+  constexpr void operator()(Vector<T, N> &params,
+                            const Vector<T, N> &grad,
+                            UpdateState<T, N> &) const {
+    params -= learning_rate * grad;
+  }
+};
+
+// heavy-ball momentum, v = μ v − η g, x += v
+template <typename T>
+struct Momentum {
+  T learning_rate{T(0.01)};
+  T momentum{T(0.9)};
+
+  template <std::size_t N>
+  constexpr void operator()(Vector<T, N> &params,
+                            const Vector<T, N> &grad,
+                            UpdateState<T, N> &state) const {
+    state.first = momentum * state.first - learning_rate * grad;
+    params += state.first;
+  }
+};
+
+// Adam: bias-corrected moving averages of g and g², one step size per parameter
+template <typename T>
+struct Adam {
+  T learning_rate{T(0.001)};
+  T beta1{T(0.9)};
+  T beta2{T(0.999)};
+  T epsilon{T(1e-8)};
+
+  template <std::size_t N>
+  constexpr void operator()(Vector<T, N> &params,
+                            const Vector<T, N> &grad,
+                            UpdateState<T, N> &state) const {
+    state.steps++;
+    const T correction1 = T(1) - constexpr_math::pow(beta1, T(state.steps));
+    const T correction2 = T(1) - constexpr_math::pow(beta2, T(state.steps));
+    for (std::size_t i = 0; i < params.size(); i++) {
+      const T g = grad[i];
+      state.first[i] = beta1 * state.first[i] + (T(1) - beta1) * g;
+      state.second[i] = beta2 * state.second[i] + (T(1) - beta2) * g * g;
+      const T m = state.first[i] / correction1;
+      const T v = state.second[i] / correction2;
+      params[i] -= learning_rate * m / (constexpr_math::sqrt(v) + epsilon);
+    }
+  }
+};
+
+// progress after each epoch, passed to the observer of a stochastic minimisation
+template <typename T>
+struct EpochInfo {
+  std::size_t epoch{};                // 1-based
+  T loss{};                           // mean batch loss over the epoch
+  std::size_t num_samples{};          // samples visited so far
+  std::chrono::nanoseconds elapsed{}; // wall time since the start
+  double samples_per_second{};        // throughput so far
+};
+
+template <typename T, std::size_t N>
+class StochasticResult {
+private:
+  Vector<T, N> m_point{};
+  T m_loss{}; // mean batch loss over the last epoch
+  std::size_t m_num_epochs{};
+  std::size_t m_num_batches{};
+  std::size_t m_num_samples{};
+  std::chrono::nanoseconds m_elapsed{};
+
+public:
+  StochasticResult(const Vector<T, N> &point,
+                   T loss,
+                   std::size_t num_epochs,
+                   std::size_t num_batches,
+                   std::size_t num_samples,
+                   std::chrono::nanoseconds elapsed)
+      : m_point(point), m_loss(loss), m_num_epochs(num_epochs),
+        m_num_batches(num_batches), m_num_samples(num_samples), m_elapsed(elapsed) {
+  }
+
+  const Vector<T, N> &point() const {
+    return m_point;
+  }
+  T loss() const {
+    return m_loss;
+  }
+  std::size_t num_epochs() const {
+    return m_num_epochs;
+  }
+  // gradient evaluations, one per batch
+  std::size_t num_batches() const {
+    return m_num_batches;
+  }
+  std::size_t num_samples() const {
+    return m_num_samples;
+  }
+  std::chrono::nanoseconds elapsed() const {
+    return m_elapsed;
+  }
+  double samples_per_second() const {
+    const double seconds = std::chrono::duration<double>(m_elapsed).count();
+    return seconds > 0.0 ? double(m_num_samples) / seconds : 0.0;
+  }
+};
+
+// Rule is one of Sgd<T>, Momentum<T>, Adam<T>; Gradient selects the backend as in
+// Optimiser. An observer returning false stops after the current epoch.
+template <typename T, typename Rule = Adam<T>, typename Gradient = ForwardGradient>
+class StochasticOptimiser {
+private:
+  std::size_t m_batch_size{};
+  std::size_t m_num_epochs{};
+  Rule m_rule{};
+  std::uint64_t m_seed{};
+  Gradient m_gradient{};
+
+public:
+  StochasticOptimiser(std::size_t batch_size,
+                      std::size_t num_epochs,
+                      Rule rule = Rule{},
+                      std::uint64_t seed = 0)
+      : m_batch_size(std::max<std::size_t>(batch_size, 1)), m_num_epochs(num_epochs),
+        m_rule(rule), m_seed(seed) {
+  }
+
+  // per-batch loss, loss(batch, params...) with batch a std::span<const std::size_t>
+  // of sample indices; it should return the mean loss over the batch
+  template <typename BatchLoss, std::size_t N, typename Observer = NoObserver>
+  StochasticResult<T, N> minimise_batches(std::size_t num_samples,
+                                          BatchLoss loss,
+                                          const Vector<T, N> &start,
+                                          Observer &&observer = Observer{}) {
+    if (num_samples == 0)
+      throw std::invalid_argument("StochasticOptimiser: empty dataset");
+
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point start_time = Clock::now();
+
+    // buffers allocated once: parameters, rule state and index permutation
+    Vector<T, N> params{start};
+    Vector<T, N> zero{start};
+    for (std::size_t i = 0; i < zero.size(); i++)
+      zero[i] = T(0);
+    UpdateState<T, N> state{zero, zero, 0};
+    std::vector<std::size_t> indices(num_samples);
+    std::iota(indices.begin(), indices.end(), std::size_t(0));
+    std::mt19937_64 generator(m_seed);
+
+    T epoch_loss{0};
+    std::size_t num_epochs{0}, num_batches{0}, num_visited{0};
+    while (num_epochs < m_num_epochs) {
+      num_epochs++;
+      std::shuffle(indices.begin(), indices.end(), generator);
+
+      T loss_sum{0};
+      for (std::size_t begin = 0; begin < num_samples; begin += m_batch_size) {
+        const std::span<const std::size_t> batch(
+            indices.data() + begin, std::min(m_batch_size, num_samples - begin));
+        auto objective = [&](const auto &...args) { return loss(batch, args...); };
+
+        const FirstOrder<T, N> current{
+            m_gradient.value_and_gradient(objective, params)};
+        m_rule(params, current.gradient, state);
+        loss_sum += current.value * T(batch.size());
+        num_batches++;
+      }
+      num_visited += num_samples;
+      epoch_loss = loss_sum / T(num_samples);
+
+      const std::chrono::nanoseconds elapsed = Clock::now() - start_time;
+      const double seconds = std::chrono::duration<double>(elapsed).count();
+      const EpochInfo<T> info{num_epochs,
+                              epoch_loss,
+                              num_visited,
+                              elapsed,
+                              seconds > 0.0 ? double(num_visited) / seconds : 0.0};
+      if (not notify_observer(observer, info))
+        break;
+    }
+
+    return StochasticResult<T, N>(params,
+                                  epoch_loss,
+                                  num_epochs,
+                                  num_batches,
+                                  num_visited,
+                                  Clock::now() - start_time);
+  }
+
+  // per-sample loss, loss(index, params...); batches minimise the mean over their
+  // samples, summed as in sum_over
+  template <typename Loss, std::size_t N, typename Observer = NoObserver>
+  StochasticResult<T, N> minimise_over(std::size_t num_samples,
+                                       Loss loss,
+                                       const Vector<T, N> &start,
+                                       Observer &&observer = Observer{}) {
+    auto batch_loss = [&loss](std::span<const std::size_t> batch,
+                              const auto &...params) {
+      auto term = [&](std::size_t k, const auto &...p) { return loss(batch[k], p...); };
+      return sum_over(batch.size(), term)(params...) * (T(1) / T(batch.size()));
+    };
+    return minimise_batches(
+        num_samples, batch_loss, start, std::forward<Observer>(observer));
+  }
+
+  // per-sample loss over the samples of data, loss(sample, params...)
+  template <std::ranges::random_access_range Dataset,
+            typename Loss,
+            std::size_t N,
+            typename Observer = NoObserver>
+    requires std::ranges::sized_range<Dataset>
+  StochasticResult<T, N> minimise_over(const Dataset &data,
+                                       Loss loss,
+                                       const Vector<T, N> &start,
+                                       Observer &&observer = Observer{}) {
+    auto by_index = [&data, &loss](std::size_t index, const auto &...params) {
+      const auto offset = std::ranges::range_difference_t<const Dataset>(index);
+      return loss(std::ranges::begin(data)[offset], params...);
+    };
+    return minimise_over(
+        std::ranges::size(data), by_index, start, std::forward<Observer>(observer));
+  }
+};
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "thread_pool.h"
+#include <algorithm>
+#include <cstddef>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+// Objectives summed over a dataset, e.g. least-squares fits
+//   sum_over(data, term)(params...) = Σ_i term(data[i], params...)
+// The result is an ordinary objective: it can be passed to Optimiser::minimise, to
+// gradient() or to any other backend, and params are whatever those pass (Dual<T>,
+// MultiDual<T, K>, one std::span for runtime-size points, ...).
+//   - the samples are split into chunks of chunk_size, summed on the threads of a
+//     ThreadPool; term is shared by every thread, so it must be safe to call
+//     concurrently
+//   - within a chunk, four independent accumulators break the dependency chain of
+//     the additions, so consecutive samples (real and tangent parts) are summed in
+//     parallel lanes
+//   - the chunk sums are then added in chunk order: value and derivatives are
+//     identical whatever the number of threads
+//   - with reverse mode (Var<T>) the chunks are summed serially, since the tape
+//     cannot be recorded from several threads
+
+struct SumOverOptions {
+  std::size_t chunk_size{4096}; // samples per chunk, fixes the summation order
+  ThreadPool *pool{nullptr};    // default_thread_pool() if null
+};
+
+// values recorded onto a tape, which must stay on a single thread
+template <typename S>
+concept records_onto_tape = requires(const S &s) { s.tape(); };
+
+// sum of term(i, params...) for i in [0, count), for data held outside of a range
+// (e.g. one array per column)
+template <typename Term>
+class SumOver {
+private:
+  std::size_t m_count{};
+  Term m_term;
+  SumOverOptions m_options{};
+
+public:
+  SumOver(std::size_t count, Term term, const SumOverOptions &options = {})
+      : m_count(count), m_term(std::move(term)), m_options(options) {
+  }
+
+  std::size_t size() const {
+    return m_count;
+  }
+
+  template <typename... Params>
+  auto operator()(Params... params) const {
+    using Sum = decltype(m_term(std::size_t(0), params...));
+
+    // term(begin) + ... + term(end - 1), four lanes then combined pairwise
+    auto chunk_sum = [&](std::size_t begin, std::size_t end) {
+      Sum s0{}, s1{}, s2{}, s3{};
+      std::size_t i = begin;
+      for (; i + 4 <= end; i += 4) {
+        s0 = s0 + m_term(i, params...);
+        s1 = s1 + m_term(i + 1, params...);
+        s2 = s2 + m_term(i + 2, params...);
+        s3 = s3 + m_term(i + 3, params...);
+      }
+      for (; i < end; i++)
+        s0 = s0 + m_term(i, params...);
+      return (s0 + s1) + (s2 + s3);
+    };
+
+    const std::size_t chunk_size = std::max<std::size_t>(m_options.chunk_size, 1);
+    const std::size_t num_chunks = (m_count + chunk_size - 1) / chunk_size;
+    if (num_chunks <= 1)
+      return chunk_sum(0, m_count);
+
+    std::vector<Sum> partials(num_chunks);
+    auto sum_chunk = [&](std::size_t chunk) {
+      partials[chunk] =
+          chunk_sum(chunk * chunk_size, std::min((chunk + 1) * chunk_size, m_count));
+    };
+    if constexpr (records_onto_tape<Sum>) {
+      for (std::size_t chunk = 0; chunk < num_chunks; chunk++)
+        sum_chunk(chunk);
+    } else {
+      ThreadPool &pool =
+          m_options.pool != nullptr ? *m_options.pool : default_thread_pool();
+      pool.parallel_for(num_chunks, sum_chunk);
+    }
+
+    Sum sum{partials[0]};
+    for (std::size_t chunk = 1; chunk < num_chunks; chunk++)
+      sum = sum + partials[chunk];
+    return sum;
+  }
+};
+
+// sum of term(index, params...) over count samples
+template <typename Term>
+SumOver<Term>
+sum_over(std::size_t count, Term term, const SumOverOptions &options = {}) {
+  return SumOver<Term>(count, std::move(term), options);
+}
+
+// sum of term(sample, params...) over the samples of data
+// data is held by reference and must outlive the objective, like a lambda capture
+template <std::ranges::random_access_range Dataset, typename Term>
+  requires std::ranges::sized_range<Dataset>
+auto sum_over(const Dataset &data, Term term, const SumOverOptions &options = {}) {
+  auto by_index = [&data, term = std::move(term)](std::size_t index,
+                                                  const auto &...params) {
+    const auto offset = std::ranges::range_difference_t<const Dataset>(index);
+    return term(std::ranges::begin(data)[offset], params...);
+  };
+  return sum_over(std::ranges::size(data), std::move(by_index), options);
+}
+
+// a temporary dataset would dangle inside the objective: store it first
+template <std::ranges::random_access_range Dataset, typename Term>
+  requires std::ranges::sized_range<Dataset>
+auto sum_over(const Dataset &&data,
+              Term term,
+              const SumOverOptions &options = {}) = delete;
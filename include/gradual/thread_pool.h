@@ -0,0 +1,228 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads running index loops with work stealing.
+//   - parallel_for(count, body) calls body(i) once for every i in [0, count); the
+//     calling thread takes part, and the call returns when every index is done
+//   - the indices start split evenly, one contiguous range per thread; a thread
+//     that runs out steals the back half of the largest remaining range, so uneven
+//     work (e.g. fits that converge at different speeds) still keeps every core busy
+//   - parallel_for from inside a body runs serially on that thread, so parallel
+//     layers can be nested without deadlock or oversubscription
+//   - the first exception thrown by body is rethrown by parallel_for, after the
+//     indices not yet started have been dropped
+// Which thread runs an index is not deterministic: callers write results by index.
+class ThreadPool {
+private:
+  // indices [begin, end) owned by one thread, the owner takes from the front
+  struct alignas(64) Range {
+    std::mutex mutex;
+    std::size_t begin{0};
+    std::size_t end{0};
+  };
+
+  // type-erased body of the current parallel_for
+  struct Job {
+    void (*call)(const void *, std::size_t);
+    const void *body;
+  };
+
+  std::vector<std::thread> m_workers;
+  std::unique_ptr<Range[]> m_ranges; // slot 0 for the calling thread
+  std::size_t m_num_slots{};
+
+  std::mutex m_submit; // one parallel_for at a time
+  std::mutex m_mutex;
+  std::condition_variable m_start, m_done;
+  Job m_job{};
+  std::size_t m_generation{0};
+  std::size_t m_active{0};
+  bool m_stop{false};
+  std::exception_ptr m_error;
+  std::atomic<bool> m_cancelled{false}; // set once body threw
+
+  static bool &inside_body() {
+    thread_local bool inside{false};
+    return inside;
+  }
+
+  bool take(std::size_t slot, std::size_t &index) {
+    while (not m_cancelled.load(std::memory_order_relaxed)) {
+      // own range first
+      {
+        Range &own = m_ranges[slot];
+        std::lock_guard lock(own.mutex);
+        if (own.begin < own.end) {
+          index = own.begin++;
+          return true;
+        }
+      }
+
+      // steal the back half of the largest range
+      std::size_t victim{slot}, largest{0};
+      for (std::size_t s = 0; s < m_num_slots; s++) {
+        Range &range = m_ranges[s];
+        std::lock_guard lock(range.mutex);
+        if (range.end - range.begin > largest) {
+          largest = range.end - range.begin;
+          victim = s;
+        }
+      }
+      if (largest == 0)
+        return false;
+
+      std::size_t stolen_begin{}, stolen_end{};
+      {
+        Range &range = m_ranges[victim];
+        std::lock_guard lock(range.mutex);
+        if (range.begin == range.end)
+          continue; // emptied meanwhile, look again
+        stolen_end = range.end;
+        stolen_begin = range.begin + (range.end - range.begin) / 2;
+        range.end = stolen_begin;
+      }
+      // run the first stolen index, keep the rest
+      Range &own = m_ranges[slot];
+      std::lock_guard lock(own.mutex);
+      own.begin = stolen_begin + 1;
+      own.end = stolen_end;
+      index = stolen_begin;
+      return true;
+    }
+    return false;
+  }
+
+  void drop_remaining() {
+    m_cancelled.store(true, std::memory_order_relaxed);
+    for (std::size_t s = 0; s < m_num_slots; s++) {
+      std::lock_guard lock(m_ranges[s].mutex);
+      m_ranges[s].end = m_ranges[s].begin;
+    }
+  }
+
+  void run(std::size_t slot, Job job) {
+    inside_body() = true;
+    std::size_t index{};
+    while (take(slot, index)) {
+      try {
+        job.call(job.body, index);
+      } catch (...) {
+        {
+          std::lock_guard lock(m_mutex);
+          if (not m_error)
+            m_error = std::current_exception();
+        }
+        drop_remaining();
+      }
+    }
+    inside_body() = false;
+  }
+
+  void worker(std::size_t slot) {
+    std::size_t seen{0};
+    while (true) {
+      Job job{};
+      {
+        std::unique_lock lock(m_mutex);
+        m_start.wait(lock, [&] { return m_stop or m_generation != seen; });
+        if (m_stop)
+          return;
+        seen = m_generation;
+        job = m_job;
+      }
+      run(slot, job);
+      {
+        std::lock_guard lock(m_mutex);
+        if (--m_active == 0)
+          m_done.notify_one();
+      }
+    }
+  }
+
+public:
+  // num_threads counts the calling thread, so ThreadPool(1) starts no worker
+  explicit ThreadPool(std::size_t num_threads = std::thread::hardware_concurrency())
+      : m_num_slots(std::max<std::size_t>(num_threads, 1)) {
+    m_ranges = std::make_unique<Range[]>(m_num_slots);
+    m_workers.reserve(m_num_slots - 1);
+    for (std::size_t slot = 1; slot < m_num_slots; slot++)
+      m_workers.emplace_back([this, slot] { worker(slot); });
+  }
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  ~ThreadPool() {
+    {
+      std::lock_guard lock(m_mutex);
+      m_stop = true;
+    }
+    m_start.notify_all();
+    for (std::thread &worker : m_workers)
+      worker.join();
+  }
+
+  // threads taking part in parallel_for, including the caller
+  std::size_t size() const {
+    return m_num_slots;
+  }
+
+  template <typename Func>
+  void parallel_for(std::size_t count, const Func &body) {
+    if (count == 0)
+      return;
+    // nested call, single thread or single index: serial
+    if (inside_body() or m_num_slots == 1 or count == 1) {
+      for (std::size_t i = 0; i < count; i++)
+        body(i);
+      return;
+    }
+
+    std::lock_guard submit(m_submit);
+    for (std::size_t s = 0; s < m_num_slots; s++) {
+      std::lock_guard lock(m_ranges[s].mutex);
+      m_ranges[s].begin = count * s / m_num_slots;
+      m_ranges[s].end = count * (s + 1) / m_num_slots;
+    }
+
+    const Job job{[](const void *f, std::size_t i) {
+                    (*static_cast<const Func *>(f))(i);
+                  },
+                  &body};
+    {
+      std::lock_guard lock(m_mutex);
+      m_job = job;
+      m_error = nullptr;
+      m_cancelled.store(false, std::memory_order_relaxed);
+      m_active = m_workers.size();
+      m_generation++;
+    }
+    m_start.notify_all();
+
+    run(0, job);
+
+    std::exception_ptr error;
+    {
+      std::unique_lock lock(m_mutex);
+      m_done.wait(lock, [&] { return m_active == 0; });
+      error = m_error;
+    }
+    if (error)
+      std::rethrow_exception(error);
+  }
+};
+
+// pool shared by the parallel algorithms of the library, one thread per core
+inline ThreadPool &default_thread_pool() {
+  static ThreadPool pool;
+  return pool;
+}
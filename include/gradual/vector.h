@@ -1,14 +1,27 @@
 #pragma once
 
+#include "constexpr_math.h"
 #include <array>
 #include <cmath>
 #include <concepts>
 #include <cstddef>
+#include <functional>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 // Fixed-size numeric vector. Supports element-wise +/- and scaling by scalars,
 // and dot product via operator*(Vector).
+// Arithmetic is lazy: +, -, scalar * and / build expression templates, and the whole
+// expression is evaluated element by element in a single loop when it is assigned to
+// a Vector (or reduced by a dot product or norm), so no temporary vectors are made.
 // Template parameter T must be floating-point or a Dual-like type.
 // Scalar-over-vector division (s / v) is intentionally unsupported.
+// N = std::dynamic_extent selects a heap-backed vector whose size is set at runtime,
+// see the specialisation below.
+// operator[] is unchecked, so element loops can vectorise; at() always checks.
+// Define GRADUAL_BOUNDS_CHECK (the default in debug builds) to check operator[] too.
 
 // Concept: Dual-like type (has value_type and real()/dual() accessors)
 template <typename U>
@@ -18,10 +31,139 @@ concept dual_like = requires(U u) {
   { u.dual() } -> std::same_as<typename U::value_type>;
 };
 
+// Concept: multi-lane Dual-like type (has value_type, real() and per-lane dual(k))
+template <typename U>
+concept multi_dual_like = requires(U u, std::size_t lane) {
+  typename U::value_type;
+  { u.real() } -> std::same_as<typename U::value_type>;
+  { u.dual(lane) } -> std::same_as<typename U::value_type>;
+};
+
+// Concept: other active scalar with a value_type and its value in real(), e.g. the
+// dependency tracer of sparsity.h
+template <typename U>
+concept real_like = requires(U u) {
+  typename U::value_type;
+  { u.real() } -> std::same_as<typename U::value_type>;
+};
+
 // Concept: numeric-like scalar for Vector elements
-// Vector can be filled with either floating-point or floating-point Dual types
+// Vector can be filled with floating-point, Dual, multi-lane Dual or other active types
 template <typename U>
-concept numeric_like = std::floating_point<U> || dual_like<U>;
+concept numeric_like =
+    std::floating_point<U> || dual_like<U> || multi_dual_like<U> || real_like<U>;
+
+template <typename T, std::size_t N>
+  requires numeric_like<T>
+class Vector;
+
+// Expression templates
+// A vector expression has value_type, a compile-time extent (N, or
+// std::dynamic_extent), size() and operator[](i) returning the i-th element by value.
+template <typename E>
+struct is_vector_expression : std::false_type {};
+
+template <typename E>
+concept vector_expression = is_vector_expression<std::remove_cvref_t<E>>::value;
+
+// two expressions that can be combined element-wise
+template <typename L, typename R>
+concept compatible_expressions =
+    vector_expression<L> and vector_expression<R> and
+    std::same_as<typename std::remove_cvref_t<L>::value_type,
+                 typename std::remove_cvref_t<R>::value_type> and
+    std::remove_cvref_t<L>::extent == std::remove_cvref_t<R>::extent;
+
+// how an operand is held inside an expression
+//   - lvalue Vectors by reference, no copy
+//   - rvalue Vectors by value, so `auto e = make_vector() + v;` cannot dangle
+//   - nested expressions by value, they only hold references and scalars
+template <typename E>
+using expression_operand = std::conditional_t<
+    std::is_lvalue_reference_v<E> and
+        std::is_same_v<std::remove_cvref_t<E>,
+                       Vector<typename std::remove_cvref_t<E>::value_type,
+                              std::remove_cvref_t<E>::extent>>,
+    const std::remove_cvref_t<E> &,
+    std::remove_cvref_t<E>>;
+
+// norms of an expression, evaluated in one pass
+template <typename Derived>
+class VectorExpression {
+public:
+  [[nodiscard]] constexpr auto norm2() const {
+    const auto &self = static_cast<const Derived &>(*this);
+    typename Derived::value_type result(0);
+    for (std::size_t i = 0; i < self.size(); ++i) {
+      const auto x = self[i];
+      result += x * x;
+    }
+    return result;
+  }
+
+  [[nodiscard]] constexpr auto norm() const {
+    return constexpr_math::sqrt(norm2());
+  }
+};
+
+// element-wise lhs[i] op rhs[i]
+template <typename Op, typename L, typename R>
+class VectorBinary : public VectorExpression<VectorBinary<Op, L, R>> {
+private:
+  L m_lhs;
+  R m_rhs;
+
+public:
+  using value_type = typename std::remove_cvref_t<L>::value_type;
+  static constexpr std::size_t extent = std::remove_cvref_t<L>::extent;
+
+  template <typename A, typename B>
+  constexpr VectorBinary(A &&lhs, B &&rhs)
+      : m_lhs(std::forward<A>(lhs)), m_rhs(std::forward<B>(rhs)) {
+  }
+
+  [[nodiscard]] constexpr std::size_t size() const {
+    return m_lhs.size();
+  }
+  constexpr value_type operator[](std::size_t index) const {
+    return Op{}(m_lhs[index], m_rhs[index]);
+  }
+};
+
+// element-wise vec[i] op scalar
+template <typename Op, typename E>
+class VectorScalar : public VectorExpression<VectorScalar<Op, E>> {
+private:
+  using operand_type = std::remove_cvref_t<E>;
+
+  E m_vec;
+  typename operand_type::value_type m_scalar;
+
+public:
+  using value_type = typename operand_type::value_type;
+  static constexpr std::size_t extent = operand_type::extent;
+
+  template <typename A>
+  constexpr VectorScalar(A &&vec, const value_type &scalar)
+      : m_vec(std::forward<A>(vec)), m_scalar(scalar) {
+  }
+
+  [[nodiscard]] constexpr std::size_t size() const {
+    return m_vec.size();
+  }
+  constexpr value_type operator[](std::size_t index) const {
+    return Op{}(m_vec[index], m_scalar);
+  }
+};
+
+template <typename T, std::size_t N>
+struct is_vector_expression<Vector<T, N>> : std::true_type {};
+
+template <typename Op, typename L, typename R>
+struct is_vector_expression<VectorBinary<Op, L, R>> : std::true_type {};
+
+template <typename Op, typename E>
+struct is_vector_expression<VectorScalar<Op, E>> : std::true_type {};
 
 template <typename T, std::size_t N>
   requires numeric_like<T>
@@ -30,24 +172,86 @@ private:
   std::array<T, N> m_data{};
 
 public:
-  // Declare friend functions - forward declaration needed
-  template <typename U, std::size_t M>
-  friend constexpr Vector<U, M> operator*(const U &scalar, const Vector<U, M> &vec);
+  using value_type = T;
+  static constexpr std::size_t extent = N;
 
   // Constructor
   constexpr Vector() = default;
   template <typename... Args>
+    requires(std::constructible_from<T, Args> and ...)
   constexpr Vector(Args... args) : m_data{static_cast<T>(args)...} {
   }
 
+  // evaluate an expression, one pass over the elements
+  template <vector_expression E>
+    requires compatible_expressions<Vector, E>
+  constexpr Vector(const E &expr) {
+    for (size_t i = 0; i < N; ++i)
+      m_data[i] = expr[i];
+  }
+
+  // element i of the result only reads element i of the operands, so an expression
+  // may refer to this vector, e.g. x = x - g * step
+  template <vector_expression E>
+    requires compatible_expressions<Vector, E>
+  constexpr Vector &operator=(const E &expr) {
+    for (size_t i = 0; i < N; ++i)
+      m_data[i] = expr[i];
+    return *this;
+  }
+
+  template <vector_expression E>
+    requires compatible_expressions<Vector, E>
+  constexpr Vector &operator+=(const E &expr) {
+    for (size_t i = 0; i < N; ++i)
+      m_data[i] += expr[i];
+    return *this;
+  }
+
+  template <vector_expression E>
+    requires compatible_expressions<Vector, E>
+  constexpr Vector &operator-=(const E &expr) {
+    for (size_t i = 0; i < N; ++i)
+      m_data[i] -= expr[i];
+    return *this;
+  }
+
+  constexpr Vector &operator*=(const T &scalar) {
+    for (T &x : m_data)
+      x *= scalar;
+    return *this;
+  }
+
+  constexpr Vector &operator/=(const T &scalar) {
+    for (T &x : m_data)
+      x /= scalar;
+    return *this;
+  }
+
   // Accessors
   [[nodiscard]] constexpr size_t size() const {
     return m_data.size();
   }
   constexpr const T &operator[](size_t index) const {
+#ifdef GRADUAL_BOUNDS_CHECK
     return m_data.at(index);
+#else
+    return m_data[index];
+#endif
   }
   constexpr T &operator[](size_t index) {
+#ifdef GRADUAL_BOUNDS_CHECK
+    return m_data.at(index);
+#else
+    return m_data[index];
+#endif
+  }
+
+  // bounds-checked access, throws std::out_of_range
+  constexpr const T &at(size_t index) const {
+    return m_data.at(index);
+  }
+  constexpr T &at(size_t index) {
     return m_data.at(index);
   }
 
@@ -61,62 +265,222 @@ public:
   }
 
   [[nodiscard]] constexpr T norm() const {
-    return std::sqrt(this->norm2());
+    return constexpr_math::sqrt(this->norm2());
   }
+};
 
-  // Vector-Vector binary ops
-  constexpr Vector operator+(const Vector &other) const {
-    Vector result;
-    for (size_t i = 0; i < N; ++i) {
-      result.m_data[i] = this->m_data[i] + other.m_data[i];
-    }
-    return result;
+// deduction guide for Vector constructor
+// thus:
+//   Vector v(1.0, 2.0, 3.0); infers Vector<double, 3>
+//   Vector vf(1.0f, 2.0f); infers Vector<float, 2>
+//   ... etc
+// at least one argument is required; integral types are not supported.
+template <typename T, typename... Rest>
+Vector(T, Rest...) -> Vector<T, 1 + sizeof...(Rest)>;
+
+// evaluating an expression keeps its element type and extent, Vector v(a + b);
+template <vector_expression E>
+Vector(const E &) -> Vector<typename E::value_type, E::extent>;
+
+// Runtime-size numeric vector, Vector<T, std::dynamic_extent>.
+// Same operations as the fixed-size vector, on contiguous heap storage, for models
+// with too many parameters to unpack as function arguments.
+// Operands of binary ops must have the same size.
+template <typename T>
+  requires numeric_like<T>
+class Vector<T, std::dynamic_extent> {
+private:
+  std::vector<T> m_data;
+
+public:
+  using value_type = T;
+  static constexpr std::size_t extent = std::dynamic_extent;
+
+  // Constructor
+  Vector() = default;
+  explicit Vector(std::size_t size) : m_data(size) {
+  }
+  Vector(std::size_t size, const T &value) : m_data(size, value) {
+  }
+  explicit Vector(std::span<const T> values) : m_data(values.begin(), values.end()) {
   }
 
-  constexpr Vector operator-(const Vector &other) const {
-    Vector result;
-    for (size_t i = 0; i < N; ++i) {
-      result.m_data[i] = this->m_data[i] - other.m_data[i];
-    }
-    return result;
+  // evaluate an expression, one pass over the elements
+  template <vector_expression E>
+    requires compatible_expressions<Vector, E>
+  Vector(const E &expr) : m_data(expr.size()) {
+    for (std::size_t i = 0; i < m_data.size(); ++i)
+      m_data[i] = expr[i];
   }
 
-  // Dot product
-  constexpr T operator*(const Vector &other) const {
-    T result(0);
-    for (size_t i = 0; i < N; ++i)
-      result += this->m_data[i] * other[i];
-    return result;
+  // in place, without reallocating when the size is unchanged
+  template <vector_expression E>
+    requires compatible_expressions<Vector, E>
+  Vector &operator=(const E &expr) {
+    m_data.resize(expr.size());
+    for (std::size_t i = 0; i < m_data.size(); ++i)
+      m_data[i] = expr[i];
+    return *this;
   }
 
-  constexpr Vector operator*(const T &scalar) const {
-    Vector result;
-    for (size_t i = 0; i < N; ++i) {
-      result.m_data[i] = this->m_data[i] * scalar;
-    }
-    return result;
+  template <vector_expression E>
+    requires compatible_expressions<Vector, E>
+  Vector &operator+=(const E &expr) {
+    for (std::size_t i = 0; i < m_data.size(); ++i)
+      m_data[i] += expr[i];
+    return *this;
   }
 
-  constexpr Vector operator/(const T &scalar) const {
-    Vector result;
-    for (size_t i = 0; i < N; ++i) {
-      result.m_data[i] = this->m_data[i] / scalar;
-    }
+  template <vector_expression E>
+    requires compatible_expressions<Vector, E>
+  Vector &operator-=(const E &expr) {
+    for (std::size_t i = 0; i < m_data.size(); ++i)
+      m_data[i] -= expr[i];
+    return *this;
+  }
+
+  Vector &operator*=(const T &scalar) {
+    for (T &x : m_data)
+      x *= scalar;
+    return *this;
+  }
+
+  Vector &operator/=(const T &scalar) {
+    for (T &x : m_data)
+      x /= scalar;
+    return *this;
+  }
+
+  // Accessors
+  [[nodiscard]] std::size_t size() const {
+    return m_data.size();
+  }
+  const T &operator[](std::size_t index) const {
+#ifdef GRADUAL_BOUNDS_CHECK
+    return m_data.at(index);
+#else
+    return m_data[index];
+#endif
+  }
+  T &operator[](std::size_t index) {
+#ifdef GRADUAL_BOUNDS_CHECK
+    return m_data.at(index);
+#else
+    return m_data[index];
+#endif
+  }
+
+  // bounds-checked access, throws std::out_of_range
+  const T &at(std::size_t index) const {
+    return m_data.at(index);
+  }
+  T &at(std::size_t index) {
+    return m_data.at(index);
+  }
+
+  // contiguous view of the elements, e.g. to pass to a span objective
+  [[nodiscard]] std::span<const T> values() const {
+    return m_data;
+  }
+  [[nodiscard]] std::span<T> values() {
+    return m_data;
+  }
+
+  // Norm
+  [[nodiscard]] T norm2() const {
+    T result(0);
+    for (const T &x : m_data)
+      result += x * x;
+
     return result;
   }
+
+  [[nodiscard]] T norm() const {
+    return std::sqrt(this->norm2());
+  }
 };
 
-// deduction guide for Vector constructor
-// thus:
-//   Vector v(1.0, 2.0, 3.0); infers Vector<double, 3>
-//   Vector vf(1.0f, 2.0f); infers Vector<float, 2>
-//   ... etc
-// at least one argument is required; integral types are not supported.
-template <typename T, typename... Rest>
-Vector(T, Rest...) -> Vector<T, 1 + sizeof...(Rest)>;
+// runtime-size vector shorthand
+template <typename T>
+using DynamicVector = Vector<T, std::dynamic_extent>;
 
-// Scalar-Vector binary ops (free functions)
-template <typename T, std::size_t N>
-constexpr Vector<T, N> operator*(const T &scalar, const Vector<T, N> &vec) {
-  return vec * scalar;
+// Vector arithmetic (free functions on vector expressions)
+// Operands must have the same element type and extent; runtime sizes must match.
+
+template <typename L, typename R>
+  requires compatible_expressions<L, R>
+constexpr auto operator+(L &&lhs, R &&rhs) {
+  return VectorBinary<std::plus<>, expression_operand<L &&>, expression_operand<R &&>>(
+      std::forward<L>(lhs), std::forward<R>(rhs));
+}
+
+template <typename L, typename R>
+  requires compatible_expressions<L, R>
+constexpr auto operator-(L &&lhs, R &&rhs) {
+  return VectorBinary<std::minus<>, expression_operand<L &&>, expression_operand<R &&>>(
+      std::forward<L>(lhs), std::forward<R>(rhs));
+}
+
+template <vector_expression E>
+constexpr auto
+operator*(E &&vec, const typename std::remove_cvref_t<E>::value_type &scalar) {
+  return VectorScalar<std::multiplies<>, expression_operand<E &&>>(std::forward<E>(vec),
+                                                                   scalar);
+}
+
+template <vector_expression E>
+constexpr auto
+operator*(const typename std::remove_cvref_t<E>::value_type &scalar, E &&vec) {
+  return VectorScalar<std::multiplies<>, expression_operand<E &&>>(std::forward<E>(vec),
+                                                                   scalar);
+}
+
+template <vector_expression E>
+constexpr auto
+operator/(E &&vec, const typename std::remove_cvref_t<E>::value_type &scalar) {
+  return VectorScalar<std::divides<>, expression_operand<E &&>>(std::forward<E>(vec),
+                                                                scalar);
 }
+
+// Dot product, a reduction evaluated immediately
+template <typename L, typename R>
+  requires compatible_expressions<L, R>
+constexpr auto operator*(const L &lhs, const R &rhs) {
+  typename std::remove_cvref_t<L>::value_type result(0);
+  for (std::size_t i = 0; i < lhs.size(); ++i)
+    result += lhs[i] * rhs[i];
+  return result;
+}
+
+// call f with the elements of a vector
+//   - fixed size N: unpacked as N arguments, f(v[0], ..., v[N-1])
+//   - runtime size: as a single std::span<const T>, f(span)
+template <typename Func, typename T, std::size_t N>
+constexpr auto invoke_unpacked(Func &f, const Vector<T, N> &args) {
+  if constexpr (N == std::dynamic_extent) {
+    return f(args.values());
+  } else {
+    return [&]<std::size_t... Indices>(std::index_sequence<Indices...>) {
+      return f(args[Indices]...);
+    }(std::make_index_sequence<N>{});
+  }
+}
+
+template <std::size_t, typename U>
+using unpacked_argument = U;
+
+template <typename Func, typename T, typename Indices>
+inline constexpr bool is_unpacked_invocable_v = false;
+
+template <typename Func, typename T, std::size_t... Indices>
+inline constexpr bool
+    is_unpacked_invocable_v<Func, T, std::index_sequence<Indices...>> =
+        std::invocable<Func &, unpacked_argument<Indices, const T &>...>;
+
+// Concept: invoke_unpacked(f, v) is valid for a Vector<T, N> v, e.g. to tell whether
+// an objective accepts Dual<T> arguments
+template <typename Func, typename T, std::size_t N>
+concept unpacked_invocable =
+    (N == std::dynamic_extent and std::invocable<Func &, std::span<const T>>) or
+    (N != std::dynamic_extent and
+     is_unpacked_invocable_v<Func, T, std::make_index_sequence<N>>);
@@ -0,0 +1,145 @@
+#include <gradual/arena.h>
+#include <gradual/optimiser.h>
+#include <gradual/reverse.h>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+using Catch::Approx;
+
+// count global heap allocations while g_counting is set
+static bool g_counting = false;
+static std::size_t g_allocations = 0;
+
+void *operator new(std::size_t size) {
+  if (g_counting)
+    g_allocations++;
+  if (void *p = std::malloc(size == 0 ? 1 : size))
+    return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept {
+  std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept {
+  std::free(p);
+}
+
+TEST_CASE("Arena hands out aligned memory linearly", "[arena]") {
+  Arena arena(256);
+
+  auto *a = arena.allocate<char>(3);
+  auto *b = arena.allocate<double>(4);
+  auto *c = arena.allocate<std::uint32_t>(2);
+
+  REQUIRE(reinterpret_cast<std::uintptr_t>(b) % alignof(double) == 0);
+  REQUIRE(reinterpret_cast<std::uintptr_t>(c) % alignof(std::uint32_t) == 0);
+  REQUIRE(reinterpret_cast<char *>(b) > a);
+  REQUIRE(reinterpret_cast<char *>(c) >= reinterpret_cast<char *>(b + 4));
+  REQUIRE(arena.heap_allocations() == 1);
+  REQUIRE(arena.bytes_in_use() == 8 + 4 * sizeof(double) + 2 * sizeof(std::uint32_t));
+}
+
+TEST_CASE("Arena grows by blocks and reuses them after rewind", "[arena]") {
+  Arena arena(128);
+
+  for (int i = 0; i < 10; i++)
+    arena.allocate<double>(8); // 64 bytes, two per block
+  REQUIRE(arena.heap_allocations() == 5);
+  REQUIRE(arena.capacity() == 5 * 128);
+  REQUIRE(arena.peak_bytes() == 10 * 64);
+
+  arena.rewind();
+  REQUIRE(arena.bytes_in_use() == 0);
+  REQUIRE(arena.reuse_count() == 1);
+
+  for (int i = 0; i < 10; i++)
+    arena.allocate<double>(8);
+  REQUIRE(arena.heap_allocations() == 5); // no new block
+  REQUIRE(arena.peak_bytes() == 10 * 64);
+
+  SECTION("Requests larger than a block get their own block") {
+    arena.allocate<double>(100);
+    REQUIRE(arena.heap_allocations() == 6);
+    REQUIRE(arena.capacity() == 5 * 128 + 800);
+  }
+
+  SECTION("Copies start empty") {
+    Arena copy(arena);
+    REQUIRE(copy.capacity() == 0);
+    REQUIRE(copy.heap_allocations() == 0);
+  }
+}
+
+TEST_CASE("Tape on an arena spans several pages", "[arena][reverse]") {
+  Arena arena;
+  Tape<double> tape(arena);
+
+  // 3000 nodes: several pages and a grown page table
+  auto x = Var<double>::variable(1.5, tape);
+  auto acc = x;
+  for (int i = 0; i < 2999; i++)
+    acc = acc * 1.001;
+  REQUIRE(tape.size() == 3000);
+
+  tape.propagate(acc.index());
+  REQUIRE(tape.adjoint(x.index()) == Approx(std::pow(1.001, 2999)));
+
+  tape.clear();
+  REQUIRE(tape.size() == 0);
+  REQUIRE(arena.bytes_in_use() == 0);
+}
+
+TEST_CASE("Reverse gradient reuses its arena without heap allocations",
+          "[arena][reverse]") {
+  auto f = [](auto x, auto y, auto z) {
+    auto sum = x * 0.0;
+    for (int i = 0; i < 500; i++)
+      sum = sum + sin(x * double(i)) * y + exp(z / double(i + 1));
+    return sum;
+  };
+  Vector point(0.3, 0.2, -0.1);
+  Arena arena;
+
+  // first recording sizes the arena
+  auto first = reverse_gradient(f, point, arena);
+  const std::size_t blocks = arena.heap_allocations();
+  REQUIRE(blocks > 1);
+
+  g_allocations = 0;
+  g_counting = true;
+  Vector<double, 3> grad{};
+  for (int i = 0; i < 10; i++)
+    grad = reverse_gradient(f, point, arena);
+  g_counting = false;
+
+  REQUIRE(g_allocations == 0);
+  REQUIRE(arena.heap_allocations() == blocks);
+  REQUIRE(arena.reuse_count() == 10);
+  for (std::size_t i = 0; i < 3; i++)
+    REQUIRE(grad[i] == first[i]);
+}
+
+TEST_CASE("Optimiser: reverse backend is allocation-free in steady state",
+          "[arena][reverse][optimiser]") {
+  auto f = [](auto x, auto y) {
+    return pow(x - 1, 2) + pow(y + 2, 2);
+  };
+
+  Optimiser<double, ReverseGradient> opt(0.1, 1e-8, 1000);
+  auto result = opt.minimise(f, Vector(5.0, 5.0));
+
+  REQUIRE(result.converged());
+  REQUIRE(result.point()[0] == Approx(1.0).margin(1e-6));
+
+  const TapeStats stats = opt.gradient_backend().stats();
+  REQUIRE(stats.heap_allocations == 1);
+  REQUIRE(stats.node_count == stats.peak_node_count);
+  REQUIRE(stats.node_count > 2);
+  REQUIRE(stats.peak_bytes > 0);
+  REQUIRE(stats.reuse_count == result.num_iterations());
+}
@@ -0,0 +1,120 @@
+#include <gradual/columnar.h>
+#include <gradual/optimiser.h>
+#include <gradual/sum_over.h>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using Catch::Approx;
+
+// file in the temporary directory, removed at the end of the test
+struct TemporaryFile {
+  std::string path;
+
+  explicit TemporaryFile(const std::string &name)
+      : path((std::filesystem::temp_directory_path() / name).string()) {
+  }
+  ~TemporaryFile() {
+    std::remove(path.c_str());
+  }
+};
+
+TEST_CASE("Columnar: write and map columns", "[columnar]") {
+  TemporaryFile file("gradual_test_columns.bin");
+  std::vector<double> x{1.0, 2.0, 3.0, 4.0, 5.0};
+  std::vector<float> weight{0.5f, 1.0f, 1.5f, 2.0f, 2.5f};
+  ColumnarWriter().add_column("x", x).add_column("weight", weight).write(file.path);
+
+  MappedDataset data(file.path);
+  REQUIRE(data.size() == 5);
+  REQUIRE(data.num_columns() == 2);
+  REQUIRE(data.column_name(1) == "weight");
+  REQUIRE(data.column_type(0) == ColumnType::float64);
+  REQUIRE(data.column_type(1) == ColumnType::float32);
+
+  auto xs = data.column<double>("x");
+  auto ws = data.column<float>("weight");
+  REQUIRE(xs.size() == 5);
+  REQUIRE(reinterpret_cast<std::uintptr_t>(xs.data()) % 64 == 0);
+  for (std::size_t i = 0; i < 5; i++) {
+    REQUIRE(xs[i] == x[i]);
+    REQUIRE(ws[i] == weight[i]);
+  }
+
+  SECTION("Chunks") {
+    REQUIRE(data.num_chunks(2) == 3);
+    const RowRange last = data.chunk(2, 2);
+    REQUIRE(last.begin == 4);
+    REQUIRE(last.size() == 1);
+    auto middle = data.column<double>("x", data.chunk(1, 2));
+    REQUIRE(middle.size() == 2);
+    REQUIRE(middle[0] == 3.0);
+  }
+
+  SECTION("Lookup errors") {
+    REQUIRE_THROWS_AS(data.column<double>("y"), std::invalid_argument);
+    REQUIRE_THROWS_AS(data.column<float>("x"), std::invalid_argument);
+  }
+
+  SECTION("Moves keep the mapping") {
+    MappedDataset moved(std::move(data));
+    REQUIRE(moved.column<double>(0)[4] == 5.0);
+  }
+}
+
+TEST_CASE("Columnar: malformed files are rejected", "[columnar]") {
+  TemporaryFile file("gradual_test_malformed.bin");
+
+  SECTION("Missing file") {
+    REQUIRE_THROWS_AS(MappedDataset(file.path + ".missing"), std::system_error);
+  }
+
+  SECTION("Not a dataset") {
+    std::ofstream(file.path) << "this is not a columnar dataset file";
+    REQUIRE_THROWS_AS(MappedDataset(file.path), std::runtime_error);
+  }
+
+  SECTION("Truncated data") {
+    std::vector<double> x(100, 1.0);
+    ColumnarWriter().add_column("x", x).write(file.path);
+    std::filesystem::resize_file(file.path, std::filesystem::file_size(file.path) - 8);
+    REQUIRE_THROWS_AS(MappedDataset(file.path), std::runtime_error);
+  }
+
+  SECTION("Columns of different lengths") {
+    std::vector<double> a(3), b(4);
+    ColumnarWriter writer;
+    writer.add_column("a", a);
+    REQUIRE_THROWS_AS(writer.add_column("b", b), std::invalid_argument);
+  }
+}
+
+TEST_CASE("Columnar: fit straight from the mapped columns", "[columnar]") {
+  TemporaryFile file("gradual_test_fit.bin");
+  const std::size_t n = 50000;
+  std::vector<double> x(n), y(n);
+  for (std::size_t i = 0; i < n; i++) {
+    x[i] = -1.0 + 2.0 * double(i) / double(n);
+    y[i] = 3.0 * x[i] - 0.5;
+  }
+  ColumnarWriter().add_column("x", x).add_column("y", y).write(file.path);
+
+  const MappedDataset data(file.path);
+  auto cost = sum_over(data.size(),
+                       [xs = data.column<double>("x"), ys = data.column<double>("y")](
+                           std::size_t i, auto a, auto b) {
+                         auto r = a * xs[i] + b - ys[i];
+                         return r * r;
+                       });
+
+  Optimiser<double, ForwardGradient, StrongWolfe<double>> opt(1.0, 1e-6);
+  auto res = opt.minimise(cost, Vector(0.0, 0.0));
+  REQUIRE(res.converged());
+  REQUIRE(res.point()[0] == Approx(3.0));
+  REQUIRE(res.point()[1] == Approx(-0.5));
+}
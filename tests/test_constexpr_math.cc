@@ -0,0 +1,111 @@
+#include <gradual/constexpr_math.h>
+#include <gradual/gradient.h>
+#include <gradual/hyper_dual.h>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using Catch::Approx;
+
+namespace portable = constexpr_math::detail;
+
+// distance in units in the last place of expected
+static double ulps(double actual, double expected) {
+  if (actual == expected)
+    return 0.0;
+  const double magnitude = std::fabs(expected);
+  const double ulp =
+      std::nextafter(magnitude, std::numeric_limits<double>::infinity()) - magnitude;
+  return std::fabs(actual - expected) / ulp;
+}
+
+TEST_CASE("Portable elementary functions match <cmath>", "[constexpr_math]") {
+  double worst[7] = {};
+  for (int i = 0; i < 20000; i++) {
+    const double x = -40.0 + 80.0 * i / 20000 + 1e-7;
+    const double positive = std::exp(-30.0 + 60.0 * i / 20000);
+    const double errors[7] = {
+        ulps(double(portable::sqrt(positive)), std::sqrt(positive)),
+        ulps(double(portable::exp(x)), std::exp(x)),
+        ulps(double(portable::log(positive)), std::log(positive)),
+        ulps(double(portable::sin(x)), std::sin(x)),
+        ulps(double(portable::cos(x)), std::cos(x)),
+        ulps(double(portable::tan(x)), std::tan(x)),
+        ulps(double(portable::pow(positive, x / 10)), std::pow(positive, x / 10)),
+    };
+    for (int k = 0; k < 7; k++)
+      worst[k] = std::max(worst[k], errors[k]);
+  }
+  for (int k = 0; k < 7; k++)
+    REQUIRE(worst[k] <= 2.0);
+}
+
+TEST_CASE("Portable elementary functions, special values", "[constexpr_math]") {
+  constexpr double inf = std::numeric_limits<double>::infinity();
+
+  SECTION("Out of range results saturate") {
+    static_assert(constexpr_math::exp(800.0) == inf);
+    static_assert(constexpr_math::exp(-800.0) == 0.0);
+    static_assert(constexpr_math::pow(10.0, 400.0) == inf);
+    static_assert(constexpr_math::exp(100.0f) ==
+                  std::numeric_limits<float>::infinity());
+  }
+
+  SECTION("Domain boundaries") {
+    static_assert(constexpr_math::sqrt(0.0) == 0.0);
+    static_assert(constexpr_math::log(0.0) == -inf);
+    static_assert(constexpr_math::log(1.0) == 0.0);
+    static_assert(constexpr_math::sqrt(-1.0) != constexpr_math::sqrt(-1.0)); // NaN
+    static_assert(constexpr_math::pow(-2.0, 0.5) != constexpr_math::pow(-2.0, 0.5));
+  }
+
+  SECTION("Integer powers are exact") {
+    static_assert(constexpr_math::pow(-2.0, 3.0) == -8.0);
+    static_assert(constexpr_math::pow(2.0, -3.0) == 0.125);
+    static_assert(constexpr_math::pow(3.0, 0.0) == 1.0);
+    static_assert(constexpr_math::pow(2.0, -1074.0) ==
+                  std::numeric_limits<double>::denorm_min());
+  }
+
+  SECTION("Subnormal and large arguments") {
+    REQUIRE(double(portable::log(5e-324)) == Approx(std::log(5e-324)));
+    REQUIRE(double(portable::sqrt(1e300)) == Approx(1e150));
+    REQUIRE(double(portable::sin(1e6)) == Approx(std::sin(1e6)));
+  }
+}
+
+TEST_CASE("Elementary functions at compile time", "[constexpr_math][dual]") {
+  SECTION("Dual") {
+    constexpr Dual<double> x(0.5, 1.0);
+    constexpr auto y =
+        exp(sin(x)) * log(x + 2.0) / sqrt(x) + pow(x, 2.5) - tan(x / 4.0);
+    static_assert(y.real() > 0.0);
+    const auto runtime = exp(sin(Dual(0.5, 1.0))) * log(Dual(0.5, 1.0) + 2.0) /
+                             sqrt(Dual(0.5, 1.0)) +
+                         pow(Dual(0.5, 1.0), 2.5) - tan(Dual(0.5, 1.0) / 4.0);
+    REQUIRE(y.real() == Approx(runtime.real()).epsilon(1e-14));
+    REQUIRE(y.dual() == Approx(runtime.dual()).epsilon(1e-14));
+  }
+
+  SECTION("Gradient of a model") {
+    // logistic model, as for a calibration constant baked into the binary
+    constexpr auto model = [](auto a, auto b) {
+      return 1.0 / (1.0 + exp(-(a * 2.0 + b))) + cos(a) * 0.1;
+    };
+    constexpr auto grad = gradient(model, Vector(0.3, -0.2));
+    const double s = 1.0 / (1.0 + std::exp(-0.4));
+    static_assert(grad[1] > 0.0);
+    REQUIRE(grad[0] == Approx(2.0 * s * (1.0 - s) - 0.1 * std::sin(0.3)));
+    REQUIRE(grad[1] == Approx(s * (1.0 - s)));
+  }
+
+  SECTION("Hessian") {
+    constexpr auto h =
+        hessian([](auto x, auto y) { return exp(x * y) + log(y); }, Vector(1.0, 2.0));
+    REQUIRE(h(0, 0) == Approx(4.0 * std::exp(2.0)));
+    REQUIRE(h(0, 1) == Approx(3.0 * std::exp(2.0)));
+    REQUIRE(h(1, 1) == Approx(std::exp(2.0) - 0.25));
+  }
+}
@@ -231,3 +231,215 @@ TEST_CASE("Gradient of 1D function", "[gradient]") {
     REQUIRE(grad[0] == Approx(-6.0)); // 2*(-3) = -6
   }
 }
+
+TEST_CASE("Gradient with tangent lanes", "[gradient][lanes]") {
+  // f(x, y, z) = x^2 + 2*y^2 + 3*z^2 + x*y
+  // ∂f/∂x = 2x + y, ∂f/∂y = 4y + x, ∂f/∂z = 6z
+  auto f = [](auto x, auto y, auto z) {
+    return x * x + y * y * 2.0 + z * z * 3.0 + x * y;
+  };
+  Vector point(2.0, -1.0, 3.0);
+
+  SECTION("All directions in one pass") {
+    auto grad = gradient<3>(f, point);
+    REQUIRE(grad[0] == Approx(3.0));
+    REQUIRE(grad[1] == Approx(-2.0));
+    REQUIRE(grad[2] == Approx(18.0));
+  }
+
+  SECTION("Chunks of two lanes, last chunk partially filled") {
+    auto grad = gradient<2>(f, point);
+    REQUIRE(grad[0] == Approx(3.0));
+    REQUIRE(grad[1] == Approx(-2.0));
+    REQUIRE(grad[2] == Approx(18.0));
+  }
+
+  SECTION("More lanes than dimensions") {
+    auto grad = gradient<8>(f, point);
+    REQUIRE(grad[0] == Approx(3.0));
+    REQUIRE(grad[1] == Approx(-2.0));
+    REQUIRE(grad[2] == Approx(18.0));
+  }
+
+  SECTION("Matches single-lane gradient") {
+    auto g = [](auto x, auto y, auto z) {
+      return exp(x) * sin(y) + log(z) / x;
+    };
+    Vector p(0.7, 1.3, 2.1);
+    auto expected = gradient(g, p);
+    auto grad = gradient<2>(g, p);
+    for (std::size_t i = 0; i < 3; i++)
+      REQUIRE(grad[i] == Approx(expected[i]));
+  }
+}
+
+TEST_CASE("Gradient with tangent lanes evaluates f ceil(N/K) times",
+          "[gradient][lanes]") {
+  int calls = 0;
+  auto f = [&calls](auto a, auto b, auto c, auto d, auto e) {
+    calls++;
+    return a * b + c * d + e;
+  };
+  Vector point(1.0, 2.0, 3.0, 4.0, 5.0);
+
+  gradient<5>(f, point);
+  REQUIRE(calls == 1);
+
+  calls = 0;
+  gradient<2>(f, point);
+  REQUIRE(calls == 3);
+
+  calls = 0;
+  gradient(f, point);
+  REQUIRE(calls == 5);
+}
+
+TEST_CASE("Gradient skips the frozen coordinates", "[gradient]") {
+  int calls = 0;
+  auto f = [&calls](auto x, auto y, auto z) {
+    calls++;
+    return x * y + z * z;
+  };
+  Vector point(2.0, 3.0, 4.0);
+
+  auto result = value_and_gradient(f, point, CoordinateMask<3>{false, true, false});
+  REQUIRE(calls == 2);
+  REQUIRE(result.value == Approx(22.0));
+  REQUIRE(result.gradient[0] == Approx(3.0));
+  REQUIRE(result.gradient[1] == 0.0);
+  REQUIRE(result.gradient[2] == Approx(8.0));
+
+  calls = 0;
+  result = value_and_gradient(f, point, CoordinateMask<3>{true, true, true});
+  REQUIRE(calls == 1);
+  REQUIRE(result.value == Approx(22.0));
+  REQUIRE(result.gradient.norm() == 0.0);
+}
+
+TEST_CASE("Value and gradient from the same passes", "[gradient]") {
+  int calls = 0;
+  auto f = [&calls](auto x, auto y, auto z) {
+    calls++;
+    return x * x * y + exp(z) - y;
+  };
+  Vector point(2.0, 3.0, 0.0);
+
+  SECTION("One dual pass per dimension") {
+    auto result = value_and_gradient(f, point);
+    REQUIRE(calls == 3);
+    REQUIRE(result.value == Approx(10.0));
+    REQUIRE(result.gradient[0] == Approx(12.0));
+    REQUIRE(result.gradient[1] == Approx(3.0));
+    REQUIRE(result.gradient[2] == Approx(1.0));
+  }
+
+  SECTION("Tangent lanes") {
+    auto result = value_and_gradient<2>(f, point);
+    REQUIRE(calls == 2);
+    REQUIRE(result.value == Approx(10.0));
+    REQUIRE(result.gradient[0] == Approx(12.0));
+    REQUIRE(result.gradient[2] == Approx(1.0));
+  }
+
+  SECTION("Backends") {
+    auto forward = ForwardGradient{}.value_and_gradient(f, point);
+    auto lanes = LaneGradient<4>{}.value_and_gradient(f, point);
+    REQUIRE(calls == 4);
+    REQUIRE(forward.value == lanes.value);
+    for (std::size_t i = 0; i < 3; i++)
+      REQUIRE(forward.gradient[i] == lanes.gradient[i]);
+  }
+}
+
+TEST_CASE("Gradient of a runtime-size objective", "[gradient][dynamic]") {
+  // f(x) = sum_i (i + 1) x_i^2 + x_0 x_{n-1}, as a function of a span of scalars
+  auto f = [](auto x) {
+    auto sum = x[0] * x[x.size() - 1];
+    for (std::size_t i = 0; i < x.size(); i++)
+      sum = sum + double(i + 1) * x[i] * x[i];
+    return sum;
+  };
+
+  const std::size_t n = 50;
+  DynamicVector<double> point(n);
+  for (std::size_t i = 0; i < n; i++)
+    point[i] = 0.1 * double(i);
+
+  auto check = [&](const DynamicVector<double> &grad) {
+    REQUIRE(grad.size() == n);
+    REQUIRE(grad[0] == Approx(point[n - 1]));
+    REQUIRE(grad[n - 1] == Approx(2.0 * double(n) * point[n - 1] + point[0]));
+    for (std::size_t i = 1; i + 1 < n; i++)
+      REQUIRE(grad[i] == Approx(2.0 * double(i + 1) * point[i]));
+  };
+
+  SECTION("One dual pass per dimension") {
+    auto result = value_and_gradient(f, point);
+    check(result.gradient);
+    REQUIRE(result.value == Approx(f(point.values())));
+  }
+
+  SECTION("Tangent lanes, with a partial last chunk") {
+    auto result = value_and_gradient<8>(f, point);
+    check(result.gradient);
+    check(gradient<8>(f, point));
+    REQUIRE(result.value == Approx(f(point.values())));
+  }
+}
+
+TEST_CASE("Hessian of quadratic forms", "[gradient][hessian]") {
+  // f(x, y, z) = x^2 + 2*y^2 + 3*z^2 + x*y
+  // H = [[2, 1, 0], [1, 4, 0], [0, 0, 6]] everywhere
+  auto f = [](auto x, auto y, auto z) {
+    return x * x + y * y * 2.0 + z * z * 3.0 + x * y;
+  };
+
+  auto hess = hessian(f, Vector(2.0, -1.0, 3.0));
+  REQUIRE(hess(0, 0) == 2.0);
+  REQUIRE(hess(0, 1) == 1.0);
+  REQUIRE(hess(1, 0) == 1.0);
+  REQUIRE(hess(1, 1) == 4.0);
+  REQUIRE(hess(2, 2) == 6.0);
+  REQUIRE(hess(0, 2) == 0.0);
+  REQUIRE(hess(2, 1) == 0.0);
+}
+
+TEST_CASE("Hessian of the Rosenbrock function", "[gradient][hessian]") {
+  // f = (1-x)^2 + 100(y-x^2)^2
+  // H = [[2 - 400(y - x^2) + 800x^2, -400x], [-400x, 200]]
+  auto f = [](auto x, auto y) {
+    return pow(1 - x, 2) + 100 * pow(y - x * x, 2);
+  };
+  const double x = -1.2, y = 1.0;
+
+  auto hess = hessian(f, Vector(x, y));
+  REQUIRE(hess(0, 0) == Approx(2.0 - 400.0 * (y - x * x) + 800.0 * x * x));
+  REQUIRE(hess(0, 1) == Approx(-400.0 * x));
+  REQUIRE(hess(1, 0) == Approx(-400.0 * x));
+  REQUIRE(hess(1, 1) == Approx(200.0));
+}
+
+TEST_CASE("Hessian evaluates only the unique entries", "[gradient][hessian]") {
+  int calls = 0;
+  auto f = [&calls](auto a, auto b, auto c, auto d) {
+    calls++;
+    return exp(a * b) + sin(c) * d;
+  };
+
+  auto hess = hessian(f, Vector(0.1, 0.2, 0.3, 0.4));
+  REQUIRE(calls == 4 * 5 / 2);
+  REQUIRE(hess(0, 1) == Approx(std::exp(0.02) * (1.0 + 0.02)));
+  REQUIRE(hess(2, 3) == Approx(std::cos(0.3)));
+  REQUIRE(hess(2, 2) == Approx(-std::sin(0.3) * 0.4));
+}
+
+TEST_CASE("Hessian at compile time", "[gradient][hessian]") {
+  constexpr auto f = [](auto x, auto y) {
+    return x * x * y + y * y * y;
+  };
+  constexpr auto hess = hessian(f, Vector(1.0, 2.0));
+  static_assert(hess(0, 0) == 4.0); // 2y
+  static_assert(hess(0, 1) == 2.0); // 2x
+  static_assert(hess(1, 1) == 12.0); // 6y
+  REQUIRE(hess(1, 0) == 2.0);
+}
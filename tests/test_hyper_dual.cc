@@ -0,0 +1,85 @@
+#include <gradual/hyper_dual.h>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+using Catch::Approx;
+
+TEST_CASE("HyperDual construction", "[hyper_dual]") {
+  HyperDual<double> d;
+  REQUIRE(d.real() == 0.0);
+  REQUIRE(d.eps1() == 0.0);
+  REQUIRE(d.eps2() == 0.0);
+  REQUIRE(d.eps12() == 0.0);
+
+  HyperDual<double> h(1.0, 2.0, 3.0, 4.0);
+  REQUIRE(h.real() == 1.0);
+  REQUIRE(h.eps1() == 2.0);
+  REQUIRE(h.eps2() == 3.0);
+  REQUIRE(h.eps12() == 4.0);
+}
+
+TEST_CASE("HyperDual second derivative of polynomials", "[hyper_dual]") {
+  // f(x) = x^3, f' = 3x^2, f'' = 6x
+  HyperDual<double> x(2.0, 1.0, 1.0, 0.0);
+  auto r = x * x * x;
+  REQUIRE(r.real() == 8.0);
+  REQUIRE(r.eps1() == 12.0);
+  REQUIRE(r.eps2() == 12.0);
+  REQUIRE(r.eps12() == 12.0);
+
+  // f(x) = 2x^2 - 3x + 1 with scalars and integers, f'' = 4
+  auto p = 2.0 * x * x - 3 * x + 1;
+  REQUIRE(p.real() == 3.0);
+  REQUIRE(p.eps1() == 5.0);
+  REQUIRE(p.eps12() == 4.0);
+}
+
+TEST_CASE("HyperDual mixed second derivative", "[hyper_dual]") {
+  // f(x, y) = x^2 y, ∂²f/∂x∂y = 2x
+  HyperDual<double> x(3.0, 1.0, 0.0, 0.0);
+  HyperDual<double> y(5.0, 0.0, 1.0, 0.0);
+  auto r = x * x * y;
+  REQUIRE(r.real() == 45.0);
+  REQUIRE(r.eps1() == 30.0); // ∂f/∂x = 2xy
+  REQUIRE(r.eps2() == 9.0);  // ∂f/∂y = x^2
+  REQUIRE(r.eps12() == 6.0);
+}
+
+TEST_CASE("HyperDual division", "[hyper_dual]") {
+  // f(x) = 1/x, f' = -1/x^2, f'' = 2/x^3
+  HyperDual<double> x(2.0, 1.0, 1.0, 0.0);
+
+  for (const auto &r : {1.0 / x, HyperDual<double>(1.0, 0.0, 0.0, 0.0) / x, 1 / x}) {
+    REQUIRE(r.real() == Approx(0.5));
+    REQUIRE(r.eps1() == Approx(-0.25));
+    REQUIRE(r.eps12() == Approx(0.25));
+  }
+
+  // f(x) = (x - 1) / 2 - (3 - x), f'' = 0
+  auto q = (x - 1.0) / 2.0 - (3.0 - x);
+  REQUIRE(q.eps1() == Approx(1.5));
+  REQUIRE(q.eps12() == Approx(0.0));
+  REQUIRE((-x).eps1() == -1.0);
+}
+
+TEST_CASE("HyperDual elementary functions", "[hyper_dual][elementary]") {
+  const double a = 0.7;
+  HyperDual<double> x(a, 1.0, 1.0, 0.0);
+
+  auto check = [](HyperDual<double> r, double value, double first, double second) {
+    REQUIRE(r.real() == Approx(value));
+    REQUIRE(r.eps1() == Approx(first));
+    REQUIRE(r.eps2() == Approx(first));
+    REQUIRE(r.eps12() == Approx(second));
+  };
+
+  check(sqrt(x), std::sqrt(a), 0.5 / std::sqrt(a), -0.25 / (a * std::sqrt(a)));
+  check(pow(x, 3), a * a * a, 3.0 * a * a, 6.0 * a);
+  check(pow(x, 0.5), std::sqrt(a), 0.5 / std::sqrt(a), -0.25 / (a * std::sqrt(a)));
+  check(exp(x), std::exp(a), std::exp(a), std::exp(a));
+  check(log(x), std::log(a), 1.0 / a, -1.0 / (a * a));
+  check(sin(x), std::sin(a), std::cos(a), -std::sin(a));
+  check(cos(x), std::cos(a), -std::sin(a), -std::cos(a));
+  const double t = std::tan(a);
+  check(tan(x), t, 1.0 + t * t, 2.0 * t * (1.0 + t * t));
+}
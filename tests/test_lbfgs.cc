@@ -0,0 +1,165 @@
+#include <gradual/lbfgs.h>
+#include <gradual/optimiser.h>
+#include <gradual/reverse.h>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+using Catch::Approx;
+
+TEST_CASE("L-BFGS history ring buffer", "[lbfgs]") {
+  LbfgsHistory<double, 2, 2> history;
+  REQUIRE(history.size() == 0);
+
+  SECTION("Empty history is the identity") {
+    auto q = history.apply(Vector(3.0, -4.0));
+    REQUIRE(q[0] == 3.0);
+    REQUIRE(q[1] == -4.0);
+  }
+
+  SECTION("Pairs from a quadratic recover its inverse Hessian") {
+    // H = diag(2, 8): y = H s
+    REQUIRE(history.push(Vector(1.0, 0.0), Vector(2.0, 0.0)));
+    REQUIRE(history.push(Vector(0.0, 1.0), Vector(0.0, 8.0)));
+    auto q = history.apply(Vector(2.0, 8.0));
+    REQUIRE(q[0] == Approx(1.0));
+    REQUIRE(q[1] == Approx(1.0));
+  }
+
+  SECTION("Oldest pair is overwritten when full") {
+    history.push(Vector(1.0, 0.0), Vector(2.0, 0.0));
+    history.push(Vector(0.0, 1.0), Vector(0.0, 8.0));
+    history.push(Vector(1.0, 0.0), Vector(4.0, 0.0));
+    REQUIRE(history.size() == 2);
+
+    // newest pairs describe H = diag(4, 8)
+    auto q = history.apply(Vector(4.0, 8.0));
+    REQUIRE(q[0] == Approx(1.0));
+    REQUIRE(q[1] == Approx(1.0));
+  }
+
+  SECTION("Pairs without positive curvature are skipped") {
+    REQUIRE_FALSE(history.push(Vector(1.0, 0.0), Vector(-1.0, 0.0)));
+    REQUIRE(history.size() == 0);
+  }
+}
+
+TEST_CASE("L-BFGS: Rosenbrock", "[lbfgs]") {
+  auto f = [](auto x, auto y) {
+    return pow(1 - x, 2) + 100 * pow(y - x * x, 2);
+  };
+
+  LbfgsOptimiser<double> opt(1e-8);
+  auto result = opt.minimise(f, Vector(-1.2, 1.0));
+
+  REQUIRE(result.converged());
+  REQUIRE(result.num_iterations() < 100);
+  REQUIRE(result.point()[0] == Approx(1.0).margin(1e-6));
+  REQUIRE(result.point()[1] == Approx(1.0).margin(1e-6));
+  REQUIRE(result.value() == Approx(0.0).margin(1e-12));
+
+  // one gradient per accepted step, at least one trial value per step
+  REQUIRE(result.num_gradient_evaluations() == result.num_iterations() + 1);
+  REQUIRE(result.num_function_evaluations() >= result.num_iterations());
+}
+
+TEST_CASE("L-BFGS: short history wraps around", "[lbfgs]") {
+  auto f = [](auto a, auto b, auto c, auto d, auto e) {
+    return pow(a - 1, 2) + 2.0 * pow(b + 1, 2) + 4.0 * pow(c - 2, 2) +
+           8.0 * pow(d, 2) + 16.0 * pow(e + 3, 2) + a * b + c * d;
+  };
+
+  LbfgsOptimiser<double, 2> opt(1e-8);
+  auto result = opt.minimise_from_zero<5>(f);
+
+  // stationary point of the coupled quadratic
+  REQUIRE(result.converged());
+  REQUIRE(result.num_iterations() > 2);
+  REQUIRE(result.point()[0] == Approx(12.0 / 7.0));
+  REQUIRE(result.point()[1] == Approx(-10.0 / 7.0));
+  REQUIRE(result.point()[2] == Approx(256.0 / 127.0));
+  REQUIRE(result.point()[3] == Approx(-16.0 / 127.0));
+  REQUIRE(result.point()[4] == Approx(-3.0));
+}
+
+TEST_CASE("L-BFGS: bounds are respected", "[lbfgs]") {
+  auto f = [](auto x, auto y) {
+    return pow(x - 3, 2) + pow(y + 2, 2) + x * y;
+  };
+
+  LbfgsOptimiser<double> opt(1e-10);
+
+  SECTION("Minimum on the boundary") {
+    // unconstrained minimum (16/3, -14/3) lies outside the box
+    auto result =
+        opt.minimise(f, Vector(0.0, 0.0), Vector(-1.0, -1.0), Vector(4.0, 1.0));
+    REQUIRE(result.converged());
+    REQUIRE(result.point()[0] == Approx(3.5));
+    REQUIRE(result.point()[1] == Approx(-1.0));
+  }
+
+  SECTION("Start outside the box is projected") {
+    auto result =
+        opt.minimise(f, Vector(10.0, -10.0), Vector(0.0, -3.0), Vector(1.0, 0.0));
+    REQUIRE(result.converged());
+    REQUIRE(result.point()[0] == Approx(1.0));
+    REQUIRE(result.point()[1] == Approx(-2.5));
+  }
+
+  SECTION("Interior minimum is unaffected") {
+    auto result =
+        opt.minimise(f, Vector(0.0, 0.0), Vector(-10.0, -10.0), Vector(10.0, 10.0));
+    REQUIRE(result.converged());
+    REQUIRE(result.point()[0] == Approx(16.0 / 3.0));
+    REQUIRE(result.point()[1] == Approx(-14.0 / 3.0));
+  }
+}
+
+TEST_CASE("L-BFGS: reverse-mode backend", "[lbfgs][reverse]") {
+  auto f = [](auto x, auto y, auto z) {
+    return exp(x - 1) + exp(1 - x) + pow(y - 2, 2) + pow(z + 1, 2);
+  };
+
+  LbfgsOptimiser<double, 4, ReverseGradient> opt(1e-8);
+  auto result = opt.minimise_from_zero<3>(f);
+
+  REQUIRE(result.converged());
+  REQUIRE(result.point()[0] == Approx(1.0));
+  REQUIRE(result.point()[1] == Approx(2.0));
+  REQUIRE(result.point()[2] == Approx(-1.0));
+
+  SECTION("Objective taking only Var") {
+    auto var_only = [](Var<double> x, Var<double> y, Var<double> z) {
+      return exp(x - 1.0) + exp(1.0 - x) + pow(y - 2.0, 2.0) + pow(z + 1.0, 2.0);
+    };
+    auto var_result = opt.minimise_from_zero<3>(var_only);
+    REQUIRE(var_result.converged());
+    REQUIRE(var_result.point()[0] == Approx(1.0));
+    REQUIRE(var_result.point()[1] == Approx(2.0));
+    REQUIRE(var_result.point()[2] == Approx(-1.0));
+    // every trial is a backend pass, and the accepted one supplies the next gradient
+    REQUIRE(var_result.num_gradient_evaluations() ==
+            var_result.num_function_evaluations() + 1);
+  }
+}
+
+TEST_CASE("L-BFGS: max iterations", "[lbfgs]") {
+  auto f = [](auto x, auto y) {
+    return pow(1 - x, 2) + 100 * pow(y - x * x, 2);
+  };
+
+  LbfgsOptimiser<double> opt(1e-12, 3);
+  auto result = opt.minimise(f, Vector(-1.2, 1.0));
+
+  REQUIRE_FALSE(result.converged());
+  REQUIRE(result.num_iterations() == 3);
+}
+
+TEST_CASE("L-BFGS: at compile time", "[lbfgs][constexpr]") {
+  constexpr auto result = LbfgsOptimiser<double, 4>(1e-10).minimise(
+      [](auto x, auto y) { return pow(1 - x, 2) + 100 * pow(y - x * x, 2); },
+      Vector(-1.2, 1.0));
+  static_assert(result.converged());
+  static_assert(result.num_iterations() < 100);
+  REQUIRE(result.point()[0] == Approx(1.0));
+  REQUIRE(result.point()[1] == Approx(1.0));
+}
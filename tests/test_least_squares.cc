@@ -0,0 +1,115 @@
+#include <gradual/gradient.h>
+#include <gradual/least_squares.h>
+#include <gradual/optimiser.h>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <array>
+#include <cmath>
+
+using Catch::Approx;
+
+TEST_CASE("Jacobian of a vector-valued function", "[least_squares][gradient]") {
+  // r(x, y) = (x² y, 5x + sin y, x - y)
+  auto f = [](auto x, auto y) {
+    return Vector{x * x * y, 5.0 * x + sin(y), x - y};
+  };
+  Vector point(2.0, 0.5);
+
+  auto result = value_and_jacobian(f, point);
+  REQUIRE(result.residuals[0] == Approx(2.0));
+  REQUIRE(result.residuals[1] == Approx(10.0 + std::sin(0.5)));
+  REQUIRE(result.residuals[2] == Approx(1.5));
+
+  auto j = jacobian(f, point);
+  REQUIRE(j.rows() == 3);
+  REQUIRE(j.cols() == 2);
+  REQUIRE(j(0, 0) == Approx(2.0)); // 2xy
+  REQUIRE(j(0, 1) == Approx(4.0)); // x²
+  REQUIRE(j(1, 0) == Approx(5.0));
+  REQUIRE(j(1, 1) == Approx(std::cos(0.5)));
+  REQUIRE(j(2, 0) == Approx(1.0));
+  REQUIRE(j(2, 1) == Approx(-1.0));
+}
+
+TEST_CASE("Least squares: Rosenbrock as residuals", "[least_squares]") {
+  // f = (1 - x)² + 100 (y - x²)²
+  auto residuals = [](auto x, auto y) {
+    return Vector{1.0 - x, 10.0 * (y - x * x)};
+  };
+
+  LeastSquaresOptimiser<double> opt(1e-10);
+  auto result = opt.minimise(residuals, Vector(-1.2, 1.0));
+  REQUIRE(result.converged());
+  REQUIRE(result.num_iterations() < 30);
+  REQUIRE(result.point()[0] == Approx(1.0));
+  REQUIRE(result.point()[1] == Approx(1.0));
+  REQUIRE(result.value() == Approx(0.0).margin(1e-20));
+}
+
+TEST_CASE("Least squares: curve fit against gradient descent", "[least_squares]") {
+  // y = 2 exp(-0.5 t) + 0.3 with a small deterministic perturbation
+  constexpr std::size_t m = 20;
+  std::array<double, m> t{}, y{};
+  for (std::size_t i = 0; i < m; i++) {
+    t[i] = 0.25 * double(i);
+    y[i] = 2.0 * std::exp(-0.5 * t[i]) + 0.3 + 0.01 * std::sin(3.0 * double(i));
+  }
+  auto residuals = [&](auto a, auto k, auto c) {
+    Vector<decltype(a), m> r;
+    for (std::size_t i = 0; i < m; i++)
+      r[i] = a * exp(k * (-t[i])) + c - y[i];
+    return r;
+  };
+  auto sum_of_squares = [&](auto a, auto k, auto c) {
+    auto sum = a * 0.0;
+    for (std::size_t i = 0; i < m; i++) {
+      auto r = a * exp(k * (-t[i])) + c - y[i];
+      sum = sum + r * r;
+    }
+    return sum;
+  };
+  const Vector start(1.0, 1.0, 0.0);
+
+  LeastSquaresOptimiser<double> lm(1e-8);
+  auto fit = lm.minimise(residuals, start);
+  REQUIRE(fit.converged());
+  REQUIRE(fit.num_iterations() < 50);
+  REQUIRE(fit.point()[0] == Approx(2.0).margin(2e-2));
+  REQUIRE(fit.point()[1] == Approx(0.5).margin(2e-2));
+  REQUIRE(fit.point()[2] == Approx(0.3).margin(2e-2));
+
+  // same minimum, value and gradient as the scalar sum of squares
+  auto check = value_and_gradient(sum_of_squares, fit.point());
+  REQUIRE(fit.value() == Approx(check.value));
+  REQUIRE(check.gradient.norm() < 1e-6);
+
+  Optimiser descent(1e-3, 1e-8, 100000);
+  auto slow = descent.minimise(sum_of_squares, start);
+  REQUIRE(slow.num_iterations() > 10 * fit.num_iterations());
+}
+
+TEST_CASE("Least squares: rank-deficient Jacobian", "[least_squares]") {
+  // only x + y is determined, the Gauss-Newton system is singular
+  auto residuals = [](auto x, auto y) {
+    return Vector{x + y - 2.0, 2.0 * (x + y) - 4.0};
+  };
+
+  LeastSquaresOptimiser<double> opt(1e-10);
+  auto result = opt.minimise(residuals, Vector(0.0, 0.0));
+  REQUIRE(result.converged());
+  REQUIRE(result.point()[0] + result.point()[1] == Approx(2.0));
+}
+
+TEST_CASE("Least squares: at compile time", "[least_squares][constexpr]") {
+  // exponential decay a e^{-k t} through t = 0, 1, 2 with a = 2, k = 0.5
+  constexpr auto residuals = [](auto a, auto k) {
+    return Vector{a - 2.0,
+                  a * exp(-k) - 1.2130613194252668,
+                  a * exp(-2.0 * k) - 0.7357588823428847};
+  };
+  constexpr auto result =
+      LeastSquaresOptimiser<double>(1e-10).minimise(residuals, Vector(1.0, 1.0));
+  static_assert(result.converged());
+  REQUIRE(result.point()[0] == Approx(2.0));
+  REQUIRE(result.point()[1] == Approx(0.5));
+}
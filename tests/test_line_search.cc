@@ -0,0 +1,64 @@
+#include <gradual/line_search.h>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+
+using Catch::Approx;
+
+TEST_CASE("Line search policies on a 1D quadratic", "[line_search]") {
+  // φ(α) = (α - 2)^2, minimum at α = 2
+  std::size_t evaluations{0};
+  auto phi = [&](double alpha) {
+    evaluations++;
+    return LineSample<double>{(alpha - 2.0) * (alpha - 2.0), 2.0 * (alpha - 2.0)};
+  };
+  const LineSample<double> start{4.0, -4.0};
+
+  SECTION("Fixed step never evaluates") {
+    auto step = FixedStep<double>{}(phi, start, 0.1);
+    REQUIRE(step.accepted);
+    REQUIRE(step.step == 0.1);
+    REQUIRE(evaluations == 0);
+  }
+
+  SECTION("Armijo backtracks from a long step") {
+    // φ(8) = 36 and φ(4) = 4 fail sufficient decrease, φ(2) = 0 passes
+    auto step = Armijo<double>{}(phi, start, 8.0);
+    REQUIRE(step.accepted);
+    REQUIRE(step.step == 2.0);
+    REQUIRE(evaluations == 3);
+  }
+
+  SECTION("Armijo accepts a short step as is") {
+    auto step = Armijo<double>{}(phi, start, 0.5);
+    REQUIRE(step.step == 0.5);
+    REQUIRE(evaluations == 1);
+  }
+
+  SECTION("Strong Wolfe expands a short step") {
+    // tight curvature condition: |φ'(α)| ≤ 0.4, only met at α = 2
+    auto step = StrongWolfe<double>{.c2 = 0.1}(phi, start, 0.5);
+    REQUIRE(step.accepted);
+    REQUIRE(step.step == 2.0);
+    REQUIRE(evaluations == 3);
+  }
+
+  SECTION("Strong Wolfe zooms into a long step") {
+    // quadratic interpolation of φ(0), φ'(0), φ(8) is exact
+    auto step = StrongWolfe<double>{}(phi, start, 8.0);
+    REQUIRE(step.accepted);
+    REQUIRE(step.step == Approx(2.0));
+    REQUIRE(evaluations == 2);
+  }
+}
+
+TEST_CASE("Line search failure is reported", "[line_search]") {
+  // φ claims descent at 0 but increases everywhere
+  auto phi = [](double alpha) {
+    return LineSample<double>{alpha, 1.0};
+  };
+  const LineSample<double> start{0.0, -1.0};
+
+  REQUIRE_FALSE(Armijo<double>{}(phi, start, 1.0).accepted);
+  REQUIRE_FALSE(StrongWolfe<double>{.max_evaluations = 10}(phi, start, 1.0).accepted);
+}
@@ -0,0 +1,99 @@
+#include <gradual/gradient.h>
+#include <gradual/masked_dual.h>
+#include <gradual/optimiser.h>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+
+using Catch::Approx;
+
+TEST_CASE("MaskedDual dependencies are part of the type", "[masked_dual]") {
+  const auto x = MaskedDual<double, 0b001>::variable(3.0);
+  const auto z = MaskedDual<double, 0b100>::variable(-2.0);
+
+  SECTION("Operations on one input keep a single tangent") {
+    const auto square = x * x + x * 2.0 - 1.0;
+    static_assert(decltype(square)::mask == 0b001);
+    static_assert(decltype(square)::size == 1);
+    REQUIRE(square.real() == 14.0);
+    REQUIRE(square.dual(0) == 8.0);
+    REQUIRE(square.dual(1) == 0.0);
+  }
+
+  SECTION("Binary operations take the union") {
+    const auto sum = x + z;
+    const auto diff = x - z;
+    const auto product = x * z;
+    const auto quotient = x / z;
+    static_assert(decltype(product)::mask == 0b101);
+    static_assert(decltype(product)::size == 2);
+    REQUIRE(sum.dual(0) == 1.0);
+    REQUIRE(sum.dual(2) == 1.0);
+    REQUIRE(diff.dual(2) == -1.0);
+    REQUIRE(product.real() == -6.0);
+    REQUIRE(product.dual(0) == -2.0);
+    REQUIRE(product.dual(2) == 3.0);
+    REQUIRE(quotient.real() == -1.5);
+    REQUIRE(quotient.dual(0) == Approx(-0.5));
+    REQUIRE(quotient.dual(2) == Approx(-0.75));
+    REQUIRE(quotient.dual(1) == 0.0);
+  }
+
+  SECTION("Scalars on the left and elementary functions") {
+    const auto a = 1.0 - x;
+    const auto b = 2 / z;
+    REQUIRE(a.real() == -2.0);
+    REQUIRE(a.dual(0) == -1.0);
+    REQUIRE(b.real() == -1.0);
+    REQUIRE(b.dual(2) == Approx(-0.5));
+    REQUIRE(exp(x).dual(0) == Approx(std::exp(3.0)));
+    REQUIRE(log(x).dual(0) == Approx(1.0 / 3.0));
+    REQUIRE(sqrt(x).dual(0) == Approx(0.5 / std::sqrt(3.0)));
+    REQUIRE(pow(x, 3).dual(0) == Approx(27.0));
+    REQUIRE(sin(z).dual(2) == Approx(std::cos(-2.0)));
+    REQUIRE(cos(z).dual(2) == Approx(-std::sin(-2.0)));
+    REQUIRE(tan(z).dual(2) == Approx(1.0 + std::tan(-2.0) * std::tan(-2.0)));
+  }
+}
+
+TEST_CASE("Gradient with dependency masks", "[masked_dual][gradient]") {
+  SECTION("Separable sum, one tangent per term") {
+    auto f = [](auto... x) { return (... + (exp(x * 0.5) + sin(x) + x * x * 0.1)); };
+    Vector point(0.5, 1.0, -0.5, 2.0, 0.25, -1.5, 0.75, 3.0);
+
+    const auto masked = masked_value_and_gradient(f, point);
+    const auto forward = value_and_gradient(f, point);
+    REQUIRE(masked.value == Approx(forward.value));
+    for (std::size_t i = 0; i < 8; i++)
+      REQUIRE(masked.gradient[i] == Approx(forward.gradient[i]));
+  }
+
+  SECTION("Coupled terms") {
+    auto f = [](auto x, auto y, auto z) {
+      return x * y + pow(z - 3.0, 2) / (1.0 + x * x) + 2.0 * y;
+    };
+    Vector point(0.3, -1.2, 2.0);
+    const auto masked = masked_gradient(f, point);
+    const auto forward = gradient(f, point);
+    for (std::size_t i = 0; i < 3; i++)
+      REQUIRE(masked[i] == Approx(forward[i]));
+  }
+
+  SECTION("At compile time") {
+    constexpr auto grad = masked_gradient(
+        [](auto x, auto y) { return x * x * y + 3.0 * y; }, Vector(2.0, 5.0));
+    static_assert(grad[0] == 20.0);
+    static_assert(grad[1] == 7.0);
+  }
+
+  SECTION("As an Optimiser backend") {
+    auto f = [](auto x, auto y) {
+      return (x - 1.0) * (x - 1.0) + 10.0 * (y + 2.0) * (y + 2.0);
+    };
+    Optimiser<double, MaskedGradient, StrongWolfe<double>> opt(1.0, 1e-8, 1000);
+    auto result = opt.minimise(f, Vector(0.0, 0.0));
+    REQUIRE(result.converged());
+    REQUIRE(result.point()[0] == Approx(1.0));
+    REQUIRE(result.point()[1] == Approx(-2.0));
+  }
+}
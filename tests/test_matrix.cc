@@ -0,0 +1,37 @@
+#include <gradual/matrix.h>
+#include <catch2/catch_test_macros.hpp>
+#include <stdexcept>
+
+TEST_CASE("Matrix construction and access", "[matrix]") {
+  Matrix<double, 2, 3> m;
+  REQUIRE(m.rows() == 2);
+  REQUIRE(m.cols() == 3);
+  REQUIRE(m(1, 2) == 0.0);
+
+  m(1, 2) = 4.0;
+  REQUIRE(m(1, 2) == 4.0);
+  REQUIRE(m(0, 2) == 0.0);
+
+  REQUIRE(m.at(1, 2) == 4.0);
+  REQUIRE_THROWS_AS(m.at(0, 3), std::out_of_range);
+  REQUIRE_THROWS_AS(m.at(2, 0), std::out_of_range);
+
+  auto id = Matrix<double, 3, 3>::identity();
+  for (std::size_t i = 0; i < 3; i++)
+    for (std::size_t j = 0; j < 3; j++)
+      REQUIRE(id(i, j) == (i == j ? 1.0 : 0.0));
+}
+
+TEST_CASE("Matrix-Vector product", "[matrix]") {
+  Matrix<double, 2, 3> m;
+  m(0, 0) = 1.0;
+  m(0, 1) = 2.0;
+  m(0, 2) = 3.0;
+  m(1, 0) = -1.0;
+  m(1, 2) = 0.5;
+
+  auto r = m * Vector(1.0, 1.0, 2.0);
+  REQUIRE(r.size() == 2);
+  REQUIRE(r[0] == 9.0);
+  REQUIRE(r[1] == 0.0);
+}
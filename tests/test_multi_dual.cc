@@ -0,0 +1,169 @@
+#include <gradual/multi_dual.h>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+using Catch::Approx;
+
+TEST_CASE("MultiDual construction", "[multi_dual]") {
+  SECTION("Constructor with no arguments") {
+    MultiDual<double, 3> d;
+    REQUIRE(d.real() == 0.0);
+    for (std::size_t k = 0; k < 3; k++)
+      REQUIRE(d.dual(k) == 0.0);
+  }
+
+  SECTION("Constructor with real and dual lanes") {
+    MultiDual<double, 3> d(2.0, {1.0, 0.0, -1.0});
+    REQUIRE(d.real() == 2.0);
+    REQUIRE(d.dual(0) == 1.0);
+    REQUIRE(d.dual(1) == 0.0);
+    REQUIRE(d.dual(2) == -1.0);
+    REQUIRE(d.duals().size() == 3);
+  }
+}
+
+TEST_CASE("MultiDual arithmetic", "[multi_dual]") {
+  // x seeded on lane 0, y seeded on lane 1
+  MultiDual<double, 2> x(3.0, {1.0, 0.0});
+  MultiDual<double, 2> y(4.0, {0.0, 1.0});
+
+  SECTION("Addition and subtraction") {
+    auto sum = x + y;
+    auto diff = x - y;
+    REQUIRE(sum.real() == 7.0);
+    REQUIRE(sum.dual(0) == 1.0);
+    REQUIRE(sum.dual(1) == 1.0);
+    REQUIRE(diff.real() == -1.0);
+    REQUIRE(diff.dual(0) == 1.0);
+    REQUIRE(diff.dual(1) == -1.0);
+  }
+
+  SECTION("Multiplication - product rule on every lane") {
+    // f = x * y, ∂f/∂x = y, ∂f/∂y = x
+    auto r = x * y;
+    REQUIRE(r.real() == 12.0);
+    REQUIRE(r.dual(0) == 4.0);
+    REQUIRE(r.dual(1) == 3.0);
+  }
+
+  SECTION("Division - quotient rule on every lane") {
+    // f = x / y, ∂f/∂x = 1/y, ∂f/∂y = -x/y^2
+    auto r = x / y;
+    REQUIRE(r.real() == Approx(0.75));
+    REQUIRE(r.dual(0) == Approx(0.25));
+    REQUIRE(r.dual(1) == Approx(-3.0 / 16.0));
+  }
+
+  SECTION("Unary negation") {
+    auto r = -x;
+    REQUIRE(r.real() == -3.0);
+    REQUIRE(r.dual(0) == -1.0);
+    REQUIRE(r.dual(1) == 0.0);
+  }
+}
+
+TEST_CASE("MultiDual-scalar interactions", "[multi_dual]") {
+  MultiDual<double, 2> x(4.0, {2.0, -1.0});
+
+  SECTION("Floating-point scalars") {
+    auto r1 = 3.0 + x;
+    auto r2 = 10.0 - x;
+    auto r3 = x * 2.0;
+    auto r4 = 20.0 / x;
+    REQUIRE(r1.real() == 7.0);
+    REQUIRE(r1.dual(0) == 2.0);
+    REQUIRE(r2.real() == 6.0);
+    REQUIRE(r2.dual(1) == 1.0);
+    REQUIRE(r3.real() == 8.0);
+    REQUIRE(r3.dual(0) == 4.0);
+    REQUIRE(r4.real() == 5.0);
+    REQUIRE(r4.dual(0) == Approx(-2.5));
+    REQUIRE(r4.dual(1) == Approx(1.25));
+  }
+
+  SECTION("Integer scalars") {
+    auto r1 = 1 + x;
+    auto r2 = 1 - x;
+    auto r3 = 2 * x;
+    auto r4 = x / 2;
+    REQUIRE(r1.real() == 5.0);
+    REQUIRE(r2.dual(0) == -2.0);
+    REQUIRE(r3.dual(1) == -2.0);
+    REQUIRE(r4.real() == 2.0);
+    REQUIRE(r4.dual(0) == 1.0);
+  }
+}
+
+TEST_CASE("MultiDual elementary functions", "[multi_dual][elementary]") {
+  MultiDual<double, 2> x(0.5, {1.0, 2.0});
+
+  SECTION("sqrt") {
+    auto r = sqrt(x);
+    REQUIRE(r.real() == Approx(std::sqrt(0.5)));
+    REQUIRE(r.dual(0) == Approx(0.5 / std::sqrt(0.5)));
+    REQUIRE(r.dual(1) == Approx(1.0 / std::sqrt(0.5)));
+  }
+
+  SECTION("pow") {
+    auto r = pow(x, 3);
+    REQUIRE(r.real() == Approx(0.125));
+    REQUIRE(r.dual(0) == Approx(0.75));
+    REQUIRE(r.dual(1) == Approx(1.5));
+  }
+
+  SECTION("exp and log") {
+    auto e = exp(x);
+    auto l = log(x);
+    REQUIRE(e.dual(1) == Approx(2.0 * std::exp(0.5)));
+    REQUIRE(l.dual(0) == Approx(2.0));
+    REQUIRE(l.dual(1) == Approx(4.0));
+  }
+
+  SECTION("sin, cos and tan") {
+    auto s = sin(x);
+    auto c = cos(x);
+    auto t = tan(x);
+    REQUIRE(s.dual(1) == Approx(2.0 * std::cos(0.5)));
+    REQUIRE(c.dual(0) == Approx(-std::sin(0.5)));
+    REQUIRE(t.dual(0) == Approx(1.0 + std::tan(0.5) * std::tan(0.5)));
+  }
+}
+
+TEST_CASE("MultiDual lane storage is aligned and padded", "[multi_dual][lanes]") {
+  using L = Lanes<double, 5>;
+  REQUIRE(L::padded % L::width == 0);
+  REQUIRE(L::padded >= 5);
+  REQUIRE(alignof(L) >= L::alignment);
+
+  // padding lanes stay zero through the kernels
+  const L a({1.0, 2.0, 3.0, 4.0, 5.0});
+  const L b = L::axpby(2.0, L::add(a, L::scale(3.0, a)), -1.0, L::sub(a, a));
+  for (std::size_t k = 0; k < 5; k++)
+    REQUIRE(b[k] == 8.0 * double(k + 1));
+  for (std::size_t k = 5; k < L::padded; k++)
+    REQUIRE(b[k] == 0.0);
+
+  // and are not exposed by MultiDual
+  MultiDual<double, 5> x(2.0, {1.0, 2.0, 3.0, 4.0, 5.0});
+  auto r = x * x - 3.0 * x + 1;
+  REQUIRE(r.duals().size() == 5);
+  for (std::size_t k = 0; k < 5; k++)
+    REQUIRE(r.dual(k) == Approx((2.0 * 2.0 - 3.0) * double(k + 1)));
+}
+
+TEST_CASE("MultiDual kernels agree in constant and runtime evaluation",
+          "[multi_dual][lanes]") {
+  // constant evaluation takes the scalar fallback, runtime takes the SIMD kernels
+  constexpr auto f = [](auto x, auto y) {
+    return (x * y - x / y) * 2.0 + y;
+  };
+  constexpr MultiDual<double, 7> x(3.0, {1.0, 0.0, 2.0, 0.0, 1.0, -1.0, 0.5});
+  constexpr MultiDual<double, 7> y(2.0, {0.0, 1.0, 1.0, 3.0, -1.0, 0.0, 0.25});
+  constexpr auto expected = f(x, y);
+  static_assert(expected.real() == 11.0);
+
+  const auto result = f(x, y);
+  REQUIRE(result.real() == expected.real());
+  for (std::size_t k = 0; k < 7; k++)
+    REQUIRE(result.dual(k) == Approx(expected.dual(k)));
+}
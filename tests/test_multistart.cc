@@ -0,0 +1,68 @@
+#include <gradual/lbfgs.h>
+#include <gradual/line_search.h>
+#include <gradual/multistart.h>
+#include <gradual/optimiser.h>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+using Catch::Approx;
+
+// double well, the left minimum (x ≈ -2.03, f ≈ -2.03) is the global one
+auto double_well = [](auto x) {
+  return (x * x - 4.0) * (x * x - 4.0) + x;
+};
+
+TEST_CASE("Multistart: finds the global minimum", "[multistart]") {
+  Optimiser<double, ForwardGradient, StrongWolfe<double>> opt(1.0, 1e-8, 1000);
+  UniformSampler<double, 1> sampler(Vector{-3.0}, Vector{3.0}, 7);
+  ThreadPool pool(4);
+
+  auto multi = minimise_multistart(opt, double_well, sampler, 32, {.pool = &pool});
+  REQUIRE(multi.num_completed() == 32);
+  REQUIRE(not multi.target_reached());
+  REQUIRE(multi.best().point()[0] == Approx(-2.0306).margin(1e-3));
+  for (const auto &result : multi.results())
+    REQUIRE(result->value() >= multi.best().value());
+}
+
+TEST_CASE("Multistart: results do not depend on the thread count", "[multistart]") {
+  LbfgsOptimiser<double> opt(1e-8);
+  UniformSampler<double, 1> sampler(Vector{-3.0}, Vector{3.0}, 11);
+  ThreadPool serial(1), parallel(4);
+
+  SECTION("All fits") {
+    auto a = minimise_multistart(opt, double_well, sampler, 40, {.pool = &serial});
+    auto b = minimise_multistart(opt, double_well, sampler, 40, {.pool = &parallel});
+    REQUIRE(a.best_index() == b.best_index());
+    for (std::size_t i = 0; i < 40; i++) {
+      REQUIRE(a.results()[i]->point()[0] == b.results()[i]->point()[0]);
+      REQUIRE(a.results()[i]->num_iterations() == b.results()[i]->num_iterations());
+    }
+  }
+
+  SECTION("Stop at a target value") {
+    MultistartOptions<double> options{.target_value = -2.0, .pool = &serial};
+    auto a = minimise_multistart(opt, double_well, sampler, 40, options);
+    options.pool = &parallel;
+    auto b = minimise_multistart(opt, double_well, sampler, 40, options);
+
+    REQUIRE(a.target_reached());
+    REQUIRE(a.best_index() == b.best_index());
+    REQUIRE(a.best().value() <= -2.0);
+    REQUIRE(a.num_completed() == a.best_index() + 1);
+    REQUIRE(b.num_completed() == b.best_index() + 1);
+  }
+}
+
+TEST_CASE("Multistart: explicit starting points", "[multistart]") {
+  Optimiser opt(1e-3, 1e-8, 100000);
+  std::vector<Vector<double, 2>> starts{{3.0, 3.0}, {-3.0, 1.0}, {2.5, -1.0}};
+  auto f = [](auto x, auto y) {
+    return double_well(x) + (y - 1.0) * (y - 1.0);
+  };
+
+  auto multi = minimise_multistart(opt, f, starts);
+  REQUIRE(multi.best_index() == 1);
+  REQUIRE(multi.best().point()[1] == Approx(1.0));
+  REQUIRE(multi.results()[0]->point()[0] == Approx(1.968).margin(1e-3));
+}
@@ -0,0 +1,127 @@
+#include <gradual/matrix.h>
+#include <gradual/newton.h>
+#include <gradual/optimiser.h>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+using Catch::Approx;
+
+TEST_CASE("Cholesky solve", "[newton][matrix]") {
+  SECTION("Symmetric positive-definite system") {
+    // A = [[4, 2, 0], [2, 5, 1], [0, 1, 3]], x = (1, -1, 2)
+    Matrix<double, 3, 3> a;
+    a(0, 0) = 4.0;
+    a(0, 1) = a(1, 0) = 2.0;
+    a(1, 1) = 5.0;
+    a(1, 2) = a(2, 1) = 1.0;
+    a(2, 2) = 3.0;
+
+    auto x = cholesky_solve(a, Vector(2.0, -1.0, 5.0));
+    REQUIRE(x.has_value());
+    REQUIRE((*x)[0] == Approx(1.0));
+    REQUIRE((*x)[1] == Approx(-1.0));
+    REQUIRE((*x)[2] == Approx(2.0));
+  }
+
+  SECTION("Indefinite matrix is rejected") {
+    Matrix<double, 2, 2> a;
+    a(0, 0) = 1.0;
+    a(0, 1) = a(1, 0) = 2.0;
+    a(1, 1) = 1.0;
+    REQUIRE_FALSE(cholesky_solve(a, Vector(1.0, 1.0)).has_value());
+  }
+}
+
+TEST_CASE("Newton: quadratic converges in one step", "[newton]") {
+  auto f = [](auto x, auto y, auto z) {
+    return (x - 1.0) * (x - 1.0) + 2.0 * (y + 2.0) * (y + 2.0) + x * y +
+           pow(z - 3.0, 2);
+  };
+
+  NewtonOptimiser<double> opt(1e-10);
+  auto result = opt.minimise(f, Vector(10.0, 10.0, 10.0));
+
+  // stationary point: 2(x-1) + y = 0, 4(y+2) + x = 0 -> x = 16/7, y = -18/7
+  REQUIRE(result.converged());
+  REQUIRE(result.num_iterations() == 1);
+  REQUIRE(result.point()[0] == Approx(16.0 / 7.0));
+  REQUIRE(result.point()[1] == Approx(-18.0 / 7.0));
+  REQUIRE(result.point()[2] == Approx(3.0));
+}
+
+TEST_CASE("Newton: Rosenbrock in tens of iterations", "[newton]") {
+  auto f = [](auto x, auto y) {
+    return pow(1 - x, 2) + 100 * pow(y - x * x, 2);
+  };
+
+  NewtonOptimiser<double> newton(1e-8);
+  auto result = newton.minimise(f, Vector(-1.0, 1.0));
+
+  REQUIRE(result.converged());
+  REQUIRE(result.num_iterations() < 50);
+  REQUIRE(result.point()[0] == Approx(1.0).margin(1e-6));
+  REQUIRE(result.point()[1] == Approx(1.0).margin(1e-6));
+  REQUIRE(result.value() == Approx(0.0).margin(1e-12));
+  REQUIRE(result.grad() <= 1e-8);
+
+  // fixed-step gradient descent on the same problem needs thousands of iterations
+  Optimiser<double> descent(0.001, 1e-6, 100000);
+  REQUIRE(descent.minimise(f, Vector(-1.0, 1.0)).num_iterations() >
+          100 * result.num_iterations());
+}
+
+TEST_CASE("Newton: indefinite Hessian is damped", "[newton]") {
+  // f(x, y) = x^4 - 2x^2 + y^2 starts at a saddle-like region near x = 0.1
+  // where f'' < 0; minima at x = ±1, y = 0
+  auto f = [](auto x, auto y) {
+    return pow(x, 4) - 2.0 * x * x + y * y;
+  };
+
+  NewtonOptimiser<double> opt(1e-10);
+  auto result = opt.minimise(f, Vector(0.1, 1.0));
+
+  REQUIRE(result.converged());
+  REQUIRE(result.point()[0] == Approx(1.0));
+  REQUIRE(result.point()[1] == Approx(0.0).margin(1e-8));
+  REQUIRE(result.value() == Approx(-1.0));
+}
+
+TEST_CASE("Newton: non-finite Hessian stops the minimisation", "[newton]") {
+  // ∂²f/∂y² = −y^{-3/2}/4 overflows to −inf at y = 1e-300
+  auto f = [](auto x, auto y) {
+    return x * x + sqrt(y);
+  };
+
+  NewtonOptimiser<double> opt(1e-10);
+  auto result = opt.minimise(f, Vector(1.0, 1e-300));
+  REQUIRE_FALSE(result.converged());
+  REQUIRE(result.num_iterations() == 0);
+  REQUIRE(result.point()[0] == 1.0);
+}
+
+TEST_CASE("Newton: max iterations and minimise_from_zero", "[newton]") {
+  auto f = [](auto x, auto y) {
+    return exp(x - 1) + exp(1 - x) + pow(y - 2, 4);
+  };
+
+  NewtonOptimiser<double> limited(1e-12, 2);
+  auto limited_result = limited.minimise_from_zero<2>(f);
+  REQUIRE(limited_result.num_iterations() == 2);
+  REQUIRE_FALSE(limited_result.converged());
+
+  NewtonOptimiser<double> opt(1e-8);
+  auto result = opt.minimise_from_zero<2>(f);
+  REQUIRE(result.converged());
+  REQUIRE(result.point()[0] == Approx(1.0));
+  REQUIRE(result.point()[1] == Approx(2.0).margin(1e-2));
+}
+
+TEST_CASE("Newton: at compile time", "[newton][constexpr]") {
+  constexpr auto result = NewtonOptimiser<double>(1e-10).minimise(
+      [](auto x, auto y) { return exp(x - 1) + exp(1 - x) + (y - x) * (y - x); },
+      Vector(0.0, 3.0));
+  static_assert(result.converged());
+  REQUIRE(result.point()[0] == Approx(1.0));
+  REQUIRE(result.point()[1] == Approx(1.0));
+  REQUIRE(result.value() == Approx(2.0));
+}
@@ -4,6 +4,7 @@
 #include <gradual/vector.h>
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <cmath>
 
 using Catch::Approx;
 
@@ -104,9 +105,42 @@ TEST_CASE("Optimiser: 1D bounded, minimum outside box", "[optimiser]") {
   // Function value at x=1 is (1-10)^2 = 81
   REQUIRE(result.value() == Approx(81.0).margin(1e-3));
 
-  // Gradient at boundary should be non-zero (pointing outside box)
-  // f'(x) = 2(x-10), at x=1: f'(1) = 2(1-10) = -18
-  REQUIRE(result.grad() > 1e-6); // Should NOT have converged to zero gradient
+  // f'(1) = -18 points outside the box: x is held on the bound, so the projected
+  // gradient vanishes and the search converges in a few iterations
+  REQUIRE(result.converged());
+  REQUIRE(result.grad() == 0.0);
+  REQUIRE(result.num_iterations() < 10);
+}
+
+TEST_CASE("Optimiser: bounded, active set", "[optimiser]") {
+  // f(x,y) = (x-3)^2 + (y-x+0.5)^2 on [0, 1]^2, constrained minimum at (1, 0.5)
+  int calls = 0;
+  auto f = [&calls](const Dual<double> &x, const Dual<double> &y) {
+    calls++;
+    return (x - 3.0) * (x - 3.0) + (y - x + 0.5) * (y - x + 0.5);
+  };
+  Vector lower{0.0, 0.0}, upper{1.0, 1.0};
+  Optimiser<double> opt(0.1, 1e-8, 1000);
+
+  SECTION("A pin released once the free variables have converged") {
+    // at (0, 0) y is held on its lower bound, until x has moved past 0.5
+    auto result = opt.minimise(f, Vector{0.0, 0.0}, lower, upper);
+    REQUIRE(result.converged());
+    REQUIRE(result.point()[0] == 1.0);
+    REQUIRE(result.point()[1] == Approx(0.5).margin(1e-8));
+    REQUIRE(result.num_iterations() < 100);
+  }
+
+  SECTION("Pinned variables are not seeded") {
+    // x is held on its upper bound: one pass per gradient, and a complete gradient
+    // at the start and to confirm the pin at the end
+    auto result = opt.minimise(f, Vector{1.0, 0.0}, lower, upper);
+    REQUIRE(result.converged());
+    REQUIRE(result.point()[0] == 1.0);
+    REQUIRE(result.point()[1] == Approx(0.5).margin(1e-8));
+    REQUIRE(calls == int(result.num_iterations()) + 4);
+    REQUIRE(result.num_gradient_evaluations() == result.num_iterations() + 2);
+  }
 }
 
 TEST_CASE("Optimiser: max iterations limit", "[optimiser]") {
@@ -220,7 +254,8 @@ TEST_CASE("Optimiser: minimise_from_zero bounded", "[optimiser][api]") {
   // Should clamp to boundary at (2,2)
   REQUIRE(result.point()[0] == Approx(2.0).margin(1e-4));
   REQUIRE(result.point()[1] == Approx(2.0).margin(1e-4));
-  REQUIRE(result.grad() > 1e-6); // Non-zero gradient at boundary
+  REQUIRE(result.converged()); // both variables held, projected gradient is zero
+  REQUIRE(result.num_iterations() < 10);
 }
 
 TEST_CASE("Optimiser: CTAD with high-dimensional vector", "[optimiser][api]") {
@@ -243,3 +278,219 @@ TEST_CASE("Optimiser: CTAD with high-dimensional vector", "[optimiser][api]") {
     REQUIRE(result.point()[i] == Approx(0.0).margin(1e-4));
   }
 }
+
+TEST_CASE("Optimiser: tangent-lane gradient backend", "[optimiser][lanes]") {
+  // same problem as the 4D test, solved with 2-lane chunks and with a single pass
+  auto f = [](auto w, auto x, auto y, auto z) {
+    return pow(w - 1, 2.0) + pow(x - 2, 2.0) + pow(y - 3, 2.0) + pow(z - 4, 2.0);
+  };
+
+  Vector start{0.0, 0.0, 0.0, 0.0};
+
+  Optimiser<double, LaneGradient<2>> chunked(0.1, 1e-6, 1000);
+  Optimiser<double, LaneGradient<4>> single_pass(0.1, 1e-6, 1000);
+  Optimiser<double> reference(0.1, 1e-6, 1000);
+
+  auto r1 = chunked.minimise(f, start);
+  auto r2 = single_pass.minimise(f, start);
+  auto r3 = reference.minimise(f, start);
+
+  REQUIRE(r1.converged());
+  REQUIRE(r2.converged());
+  REQUIRE(r1.num_iterations() == r3.num_iterations());
+  REQUIRE(r2.num_iterations() == r3.num_iterations());
+  for (std::size_t i = 0; i < 4; i++) {
+    REQUIRE(r1.point()[i] == Approx(double(i + 1)).margin(1e-4));
+    REQUIRE(r2.point()[i] == Approx(double(i + 1)).margin(1e-4));
+  }
+}
+
+TEST_CASE("Optimiser: line-search policies", "[optimiser][line_search]") {
+  // badly scaled bowl, minimum at (1, -2)
+  auto f = [](auto x, auto y) {
+    return pow(x - 1, 2) + 50.0 * pow(y + 2, 2);
+  };
+  Vector start{5.0, 5.0};
+
+  SECTION("Fixed step needs tuning") {
+    Optimiser<double> too_long(0.05, 1e-6, 1000);
+    REQUIRE_FALSE(too_long.minimise(f, start).converged());
+
+    Optimiser<double> tuned(0.001, 1e-6, 100000);
+    auto result = tuned.minimise(f, start);
+    REQUIRE(result.converged());
+    REQUIRE(result.num_iterations() > 5000);
+    REQUIRE(result.num_function_evaluations() == 0);
+  }
+
+  SECTION("Armijo backtracking from a unit step") {
+    Optimiser<double, ForwardGradient, Armijo<double>> opt(1.0, 1e-6, 1000);
+    auto result = opt.minimise(f, start);
+    REQUIRE(result.converged());
+    REQUIRE(result.num_iterations() < 500);
+    REQUIRE(result.point()[0] == Approx(1.0).margin(1e-6));
+    REQUIRE(result.point()[1] == Approx(-2.0).margin(1e-6));
+    REQUIRE(result.value() == Approx(0.0).margin(1e-10));
+  }
+
+  SECTION("Strong Wolfe from a unit step") {
+    Optimiser opt(1.0, 1e-6, 1000, StrongWolfe<double>{});
+    auto result = opt.minimise(f, start);
+    REQUIRE(result.converged());
+    REQUIRE(result.num_iterations() < 50);
+    REQUIRE(result.point()[0] == Approx(1.0).margin(1e-6));
+    REQUIRE(result.point()[1] == Approx(-2.0).margin(1e-6));
+    REQUIRE(result.value() == Approx(0.0).margin(1e-10));
+  }
+
+  SECTION("Bounded search stops on the boundary") {
+    Optimiser<double, ForwardGradient, Armijo<double>> opt(1.0, 1e-6, 1000);
+    auto result = opt.minimise(f, start, Vector(-1.0, 0.0), Vector(3.0, 10.0));
+    REQUIRE(result.converged());
+    REQUIRE(result.point()[0] == Approx(1.0).margin(1e-6));
+    REQUIRE(result.point()[1] == 0.0);
+    REQUIRE(result.num_iterations() < 50);
+  }
+}
+
+TEST_CASE("Optimiser: at compile time", "[optimiser][constexpr]") {
+  SECTION("Fixed step, same path as at run time") {
+    constexpr auto f = [](auto x, auto y) {
+      return (x - 1.0) * (x - 1.0) + 4.0 * (y + 0.5) * (y + 0.5);
+    };
+    constexpr auto result = Optimiser<double>(0.1, 1e-8).minimise(f, Vector(0.0, 0.0));
+    static_assert(result.converged());
+    static_assert(result.point()[0] > 0.999999 and result.point()[0] < 1.000001);
+
+    const auto runtime = Optimiser<double>(0.1, 1e-8).minimise(f, Vector(0.0, 0.0));
+    REQUIRE(result.num_iterations() == runtime.num_iterations());
+    REQUIRE(result.point()[0] == Approx(runtime.point()[0]));
+    REQUIRE(result.point()[1] == Approx(runtime.point()[1]));
+  }
+
+  SECTION("Strong Wolfe, transcendental objective") {
+    // minimum at x = y = log(2)
+    constexpr auto f = [](auto x, auto y) {
+      return exp(x) - 2.0 * x + (y - x) * (y - x);
+    };
+    constexpr auto result =
+        Optimiser(1.0, 1e-8, 1000, StrongWolfe<double>{}).minimise(f, Vector(0.0, 0.0));
+    static_assert(result.converged());
+    REQUIRE(result.point()[0] == Approx(std::log(2.0)));
+    REQUIRE(result.point()[1] == Approx(std::log(2.0)));
+  }
+
+  SECTION("Bounded, with the masked backend") {
+    // unconstrained minimum at (1, -0.25), x is held on its lower bound
+    constexpr auto f = [](auto x, auto y) {
+      return (x - 1.0) * (x - 1.0) + (y + 0.5) * y;
+    };
+    constexpr auto result = Optimiser<double, MaskedGradient, Armijo<double>>(1.0, 1e-8)
+                                .minimise(f,
+                                          Vector(3.0, 3.0),
+                                          Vector(2.0, -1.0),
+                                          Vector(5.0, 5.0));
+    static_assert(result.converged());
+    static_assert(result.point()[0] == 2.0);
+    REQUIRE(result.point()[1] == Approx(-0.25));
+  }
+}
+
+TEST_CASE("Optimiser: runtime-size parameters", "[optimiser][dynamic]") {
+  // chain of springs pulled towards 1, f takes a span of active scalars
+  auto f = [](auto x) {
+    auto sum = x[0] * 0.0;
+    for (std::size_t i = 0; i + 1 < x.size(); i++)
+      sum = sum + (x[i + 1] - x[i]) * (x[i + 1] - x[i]);
+    for (std::size_t i = 0; i < x.size(); i++)
+      sum = sum + (x[i] - 1.0) * (x[i] - 1.0);
+    return sum;
+  };
+  DynamicVector<double> start(200, 3.0);
+
+  SECTION("Unbounded") {
+    Optimiser<double, ForwardGradient, StrongWolfe<double>> opt(1.0, 1e-8, 1000);
+    auto result = opt.minimise(f, start);
+    REQUIRE(result.converged());
+    REQUIRE(result.point().size() == 200);
+    for (std::size_t i = 0; i < 200; i++)
+      REQUIRE(result.point()[i] == Approx(1.0).margin(1e-6));
+    REQUIRE(result.value() == Approx(0.0).margin(1e-12));
+  }
+
+  SECTION("Bounded") {
+    Optimiser<double> opt(0.1, 1e-8, 1000);
+    DynamicVector<double> lower(200, 2.0), upper(200, 4.0);
+    auto result = opt.minimise(f, start, lower, upper);
+    REQUIRE(result.converged());
+    for (std::size_t i = 0; i < 200; i++)
+      REQUIRE(result.point()[i] == Approx(2.0));
+  }
+}
+
+TEST_CASE("Optimiser: observers", "[optimiser][observer]") {
+  auto f = [](auto x, auto y) {
+    return (x - 1.0) * (x - 1.0) + 10.0 * (y + 2.0) * (y + 2.0);
+  };
+  Vector start{0.0, 0.0};
+  Optimiser<double, ForwardGradient, Armijo<double>> opt(1.0, 1e-8, 1000);
+
+  SECTION("Recorder sees every iteration") {
+    ConvergenceRecorder<double> recorder;
+    auto result = opt.minimise(f, start, recorder);
+    REQUIRE(result.converged());
+    REQUIRE(recorder.trace().size() == result.num_iterations());
+    REQUIRE(recorder.trace().front().iteration == 1);
+    REQUIRE(recorder.trace().back().value == Approx(result.value()));
+    REQUIRE(recorder.trace().back().grad_norm == Approx(result.grad()));
+
+    std::size_t num_function_evaluations{0};
+    for (const IterationInfo<double> &info : recorder.trace()) {
+      REQUIRE(info.step > 0.0);
+      REQUIRE(info.evaluation_time.count() >= 0);
+      num_function_evaluations += info.num_function_evaluations;
+    }
+    REQUIRE(num_function_evaluations == result.num_function_evaluations());
+    REQUIRE(recorder.total_evaluation_time() >=
+            recorder.trace().back().evaluation_time);
+  }
+
+  SECTION("Same path with and without an observer") {
+    auto plain = opt.minimise(f, start);
+    auto observed = opt.minimise(f, start, [](const IterationInfo<double> &) {});
+    REQUIRE(observed.num_iterations() == plain.num_iterations());
+    REQUIRE(observed.point()[0] == plain.point()[0]);
+    REQUIRE(observed.point()[1] == plain.point()[1]);
+  }
+
+  SECTION("Returning false stops early") {
+    auto result = opt.minimise(f, start, [](const IterationInfo<double> &info) {
+      return info.iteration < 2;
+    });
+    REQUIRE(result.num_iterations() == 2);
+    REQUIRE(not result.converged());
+  }
+
+  SECTION("A rejected step is not counted") {
+    // a single Armijo trial of a step far too long
+    Optimiser<double, ForwardGradient, Armijo<double>> failing(
+        100.0, 1e-8, 1000, Armijo<double>{.max_evaluations = 1});
+    ConvergenceRecorder<double> recorder;
+    auto result = failing.minimise(f, start, recorder);
+    REQUIRE(not result.converged());
+    REQUIRE(result.num_iterations() == 0);
+    REQUIRE(recorder.trace().empty());
+    REQUIRE(result.num_function_evaluations() == 1);
+  }
+
+  SECTION("Bounded and from zero") {
+    ConvergenceRecorder<double> recorder;
+    Vector lower{-1.0, -1.0}, upper{1.0, 1.0};
+    auto result = opt.minimise_from_zero(f, lower, upper, recorder);
+    REQUIRE(result.point()[1] == Approx(-1.0));
+    REQUIRE(result.converged());
+    REQUIRE(not recorder.trace().empty());
+    REQUIRE(recorder.trace().back().grad_norm == Approx(result.grad()));
+    REQUIRE(recorder.trace().back().value == Approx(result.value()));
+  }
+}
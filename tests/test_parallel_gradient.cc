@@ -0,0 +1,103 @@
+#include <gradual/gradient.h>
+#include <gradual/optimiser.h>
+#include <gradual/parallel_gradient.h>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <thread>
+
+using Catch::Approx;
+
+// no cost threshold, always takes the parallel path
+const ParallelGradientOptions always{.min_pass_time = std::chrono::nanoseconds(0)};
+
+auto coupled = [](auto a, auto b, auto c, auto d, auto e) {
+  return a * b + sin(c) * d * d + exp(e * 0.1) * a;
+};
+
+TEST_CASE("Parallel gradient matches the serial one", "[parallel_gradient]") {
+  ThreadPool pool(4);
+  ParallelGradientOptions options{always};
+  options.pool = &pool;
+  Vector point(1.0, -2.0, 0.5, 3.0, 1.5);
+
+  SECTION("One seed per pass") {
+    auto expected = value_and_gradient(coupled, point);
+    auto result = parallel_value_and_gradient(coupled, point, options);
+    REQUIRE(result.value == expected.value);
+    for (std::size_t i = 0; i < 5; i++)
+      REQUIRE(result.gradient[i] == expected.gradient[i]);
+  }
+
+  SECTION("Tangent lanes") {
+    auto expected = gradient<2>(coupled, point);
+    auto grad = parallel_gradient<2>(coupled, point, options);
+    for (std::size_t i = 0; i < 5; i++)
+      REQUIRE(grad[i] == expected[i]);
+  }
+
+  SECTION("Runtime size") {
+    auto model = [](auto x) {
+      auto sum = x[0] * 0.0;
+      for (std::size_t i = 0; i < x.size(); i++)
+        sum = sum + (x[i] - 1.0) * (x[i] - 1.0) * double(i + 1);
+      return sum;
+    };
+    DynamicVector<double> x(100, 0.0);
+    auto grad = parallel_gradient<3>(model, x, options);
+    REQUIRE(grad.size() == 100);
+    for (std::size_t i = 0; i < 100; i++)
+      REQUIRE(grad[i] == Approx(-2.0 * double(i + 1)));
+  }
+}
+
+TEST_CASE("Parallel gradient only engages above the cost threshold",
+          "[parallel_gradient]") {
+  ThreadPool pool(4);
+  std::mutex mutex;
+  std::set<std::thread::id> threads;
+  auto f = [&](auto x, auto y, auto z, auto w) {
+    {
+      std::lock_guard lock(mutex);
+      threads.insert(std::this_thread::get_id());
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    return x * y + z * w;
+  };
+  Vector point(1.0, 2.0, 3.0, 4.0);
+
+  SECTION("Cheap passes stay on the calling thread") {
+    ParallelGradientOptions options{.pool = &pool,
+                                    .min_pass_time = std::chrono::seconds(1)};
+    auto grad = parallel_gradient(f, point, options);
+    REQUIRE(threads.size() == 1);
+    REQUIRE(*threads.begin() == std::this_thread::get_id());
+    REQUIRE(grad[0] == 2.0);
+  }
+
+  SECTION("Expensive passes use the pool") {
+    ParallelGradientOptions options{.pool = &pool,
+                                    .min_pass_time = std::chrono::microseconds(100)};
+    auto grad = parallel_gradient(f, point, options);
+    REQUIRE(threads.size() > 1);
+    REQUIRE(grad[3] == 3.0);
+  }
+}
+
+TEST_CASE("Optimiser with a parallel gradient backend", "[parallel_gradient]") {
+  auto f = [](auto x, auto y) {
+    return (x - 1.0) * (x - 1.0) + (y + 2.0) * (y + 2.0);
+  };
+
+  Optimiser<double, ParallelGradient<>> opt(0.1, 1e-8);
+  auto res = opt.minimise(f, Vector(0.0, 0.0));
+  REQUIRE(res.converged());
+  REQUIRE(res.point()[0] == Approx(1.0));
+  REQUIRE(res.point()[1] == Approx(-2.0));
+
+  Optimiser<double, ForwardGradient> serial(0.1, 1e-8);
+  auto expected = serial.minimise(f, Vector(0.0, 0.0));
+  REQUIRE(res.num_iterations() == expected.num_iterations());
+}
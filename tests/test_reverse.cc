@@ -0,0 +1,183 @@
+#include <gradual/gradient.h>
+#include <gradual/optimiser.h>
+#include <gradual/reverse.h>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+using Catch::Approx;
+
+TEST_CASE("Var records operations onto the tape", "[reverse]") {
+  Tape<double> tape;
+  auto x = Var<double>::variable(3.0, tape);
+  auto y = Var<double>::variable(4.0, tape);
+
+  auto f = x * y + x; // f = xy + x, ∂f/∂x = y + 1, ∂f/∂y = x
+  REQUIRE(f.value() == 15.0);
+  REQUIRE(tape.size() == 4); // two leaves, one product, one sum
+
+  tape.propagate(f.index());
+  REQUIRE(tape.adjoint(x.index()) == 5.0);
+  REQUIRE(tape.adjoint(y.index()) == 3.0);
+}
+
+TEST_CASE("Var constants record no edges", "[reverse]") {
+  Tape<double> tape;
+  auto x = Var<double>::variable(2.0, tape);
+  Var<double> c(10.0);
+
+  auto f = x * c - c / x; // ∂f/∂x = c + c/x^2 = 12.5
+  REQUIRE(f.value() == 15.0);
+
+  tape.propagate(f.index());
+  REQUIRE(tape.adjoint(x.index()) == Approx(12.5));
+
+  auto g = c * c; // constant result, stays off the tape
+  REQUIRE(g.tape() == nullptr);
+  REQUIRE(g.value() == 100.0);
+}
+
+TEST_CASE("Var-scalar interactions", "[reverse]") {
+  Tape<double> tape;
+  auto x = Var<double>::variable(4.0, tape);
+
+  auto f = 3.0 + x - 1 + 2 * x * 0.5 - 10.0 / x + 2 / x - x / 2.0 + (1 - x) * 3;
+  // ∂f/∂x = 1 + 1 + 10/x^2 - 2/x^2 - 0.5 - 3 = -1.5 + 8/16 = -1
+  tape.propagate(f.index());
+  REQUIRE(tape.adjoint(x.index()) == Approx(-1.0));
+  REQUIRE((-x).value() == -4.0);
+}
+
+TEST_CASE("Var elementary functions", "[reverse][elementary]") {
+  const double a = 0.7;
+
+  auto derivative = [a](auto g) {
+    Tape<double> tape;
+    auto x = Var<double>::variable(a, tape);
+    auto r = g(x);
+    tape.propagate(r.index());
+    return tape.adjoint(x.index());
+  };
+
+  REQUIRE(derivative([](auto x) { return sqrt(x); }) == Approx(0.5 / std::sqrt(a)));
+  REQUIRE(derivative([](auto x) { return pow(x, 3); }) == Approx(3.0 * a * a));
+  REQUIRE(derivative([](auto x) { return pow(x, 0.5); }) == Approx(0.5 / std::sqrt(a)));
+  REQUIRE(derivative([](auto x) { return exp(x); }) == Approx(std::exp(a)));
+  REQUIRE(derivative([](auto x) { return log(x); }) == Approx(1.0 / a));
+  REQUIRE(derivative([](auto x) { return sin(x); }) == Approx(std::cos(a)));
+  REQUIRE(derivative([](auto x) { return cos(x); }) == Approx(-std::sin(a)));
+  REQUIRE(derivative([](auto x) { return tan(x); }) ==
+          Approx(1.0 + std::tan(a) * std::tan(a)));
+}
+
+TEST_CASE("Reverse gradient matches forward gradient", "[reverse][gradient]") {
+  auto f = [](auto x, auto y, auto z) {
+    return exp(x) * sin(y) + log(z) / x + pow(y - z, 2) * sqrt(z) - tan(x * 0.1);
+  };
+
+  SECTION("At point (0.7, 1.3, 2.1)") {
+    Vector point(0.7, 1.3, 2.1);
+    auto expected = gradient(f, point);
+    auto grad = reverse_gradient(f, point);
+    for (std::size_t i = 0; i < 3; i++)
+      REQUIRE(grad[i] == Approx(expected[i]));
+  }
+
+  SECTION("Reused inputs accumulate adjoints") {
+    // f(x, y) = x*x*x + x*y, ∂f/∂x = 3x^2 + y, ∂f/∂y = x
+    auto g = [](auto x, auto y) {
+      return x * x * x + x * y;
+    };
+    Vector point(2.0, 5.0);
+    auto grad = reverse_gradient(g, point);
+    REQUIRE(grad[0] == Approx(17.0));
+    REQUIRE(grad[1] == Approx(2.0));
+  }
+
+  SECTION("Function independent of its arguments") {
+    auto g = [](auto, auto) {
+      return Var<double>(3.0);
+    };
+    auto grad = reverse_gradient(g, Vector(1.0, 2.0));
+    REQUIRE(grad[0] == 0.0);
+    REQUIRE(grad[1] == 0.0);
+
+    Arena arena;
+    REQUIRE(reverse_value_and_gradient(g, Vector(1.0, 2.0), arena).value == 3.0);
+  }
+
+  SECTION("Value comes from the same recording") {
+    Vector point(0.7, 1.3, 2.1);
+    Arena arena;
+    auto result = reverse_value_and_gradient(f, point, arena);
+    auto expected = value_and_gradient(f, point);
+    REQUIRE(result.value == Approx(expected.value));
+    for (std::size_t i = 0; i < 3; i++)
+      REQUIRE(result.gradient[i] == Approx(expected.gradient[i]));
+  }
+}
+
+TEST_CASE("Reverse gradient of a runtime-size objective", "[reverse][dynamic]") {
+  auto f = [](auto x) {
+    auto sum = x[0] * 0.0;
+    for (std::size_t i = 0; i + 1 < x.size(); i++)
+      sum = sum + pow(x[i + 1] - x[i], 2) + sin(x[i]);
+    return sum;
+  };
+
+  DynamicVector<double> point(300);
+  for (std::size_t i = 0; i < point.size(); i++)
+    point[i] = std::cos(double(i));
+
+  Arena arena;
+  auto result = reverse_value_and_gradient(f, point, arena);
+  auto expected = value_and_gradient(f, point);
+  REQUIRE(result.value == Approx(expected.value));
+  for (std::size_t i = 0; i < point.size(); i++)
+    REQUIRE(result.gradient[i] == Approx(expected.gradient[i]).margin(1e-12));
+
+  // repeated recordings reuse the arena
+  const std::size_t blocks = arena.heap_allocations();
+  reverse_gradient(f, point, arena);
+  REQUIRE(arena.heap_allocations() == blocks);
+}
+
+TEST_CASE("Optimiser: reverse-mode gradient backend", "[reverse][optimiser]") {
+  auto f = [](auto w, auto x, auto y, auto z) {
+    return pow(w - 1, 2.0) + pow(x - 2, 2.0) + pow(y - 3, 2.0) + pow(z - 4, 2.0);
+  };
+
+  Vector start{0.0, 0.0, 0.0, 0.0};
+  Optimiser<double, ReverseGradient> opt(0.1, 1e-6, 1000);
+
+  auto result = opt.minimise(f, start);
+
+  REQUIRE(result.converged());
+  for (std::size_t i = 0; i < 4; i++)
+    REQUIRE(result.point()[i] == Approx(double(i + 1)).margin(1e-4));
+}
+
+TEST_CASE("Optimiser: reverse mode with an objective taking only Var",
+          "[reverse][optimiser]") {
+  // not callable with Dual<double>, so the line search goes through the backend
+  auto f = [](Var<double> x, Var<double> y) {
+    return pow(x - 1.0, 2.0) + pow(y + 2.0, 2.0) * 3.0;
+  };
+  Vector start{0.0, 0.0};
+
+  SECTION("Fixed step") {
+    Optimiser<double, ReverseGradient> opt(0.1, 1e-6, 1000);
+    auto result = opt.minimise(f, start);
+    REQUIRE(result.converged());
+    REQUIRE(result.point()[0] == Approx(1.0).margin(1e-5));
+    REQUIRE(result.point()[1] == Approx(-2.0).margin(1e-5));
+  }
+
+  SECTION("Line search") {
+    Optimiser<double, ReverseGradient, StrongWolfe<double>> opt(1.0, 1e-6, 1000);
+    auto result = opt.minimise(f, start, Vector{-5.0, -1.0}, Vector{5.0, 5.0});
+    REQUIRE(result.converged());
+    REQUIRE(result.point()[0] == Approx(1.0).margin(1e-5));
+    REQUIRE(result.point()[1] == Approx(-1.0));
+    REQUIRE(result.num_function_evaluations() > 0);
+  }
+}
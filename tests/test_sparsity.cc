@@ -0,0 +1,180 @@
+#include <gradual/gradient.h>
+#include <gradual/sparsity.h>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <array>
+#include <type_traits>
+#include <vector>
+
+using Catch::Approx;
+
+// sum of independent per-parameter terms, as in examples/variadic_model.cc
+struct Separable {
+  template <typename... X>
+  auto operator()(X... x) const {
+    return (... + (exp(x * 0.5) + sin(x) + x * x * 0.1));
+  }
+};
+
+TEST_CASE("Sparsity patterns from a tracing pass", "[sparsity]") {
+  Vector point(0.1, 0.2, 0.3, 0.4, 0.5);
+
+  SECTION("Jacobian of banded residuals") {
+    auto residuals = [](auto a, auto b, auto c, auto d, auto e) {
+      return Vector{a - 1.0, b * a, c - b, d * d + c, e / d};
+    };
+    const SparsityPattern pattern = jacobian_sparsity(residuals, point);
+    REQUIRE(pattern.rows() == 5);
+    REQUIRE(pattern.cols() == 5);
+    REQUIRE(pattern.num_nonzeros() == 9);
+    REQUIRE(pattern.row(1) == std::vector<std::size_t>{0, 1});
+    REQUIRE(pattern.row(4) == std::vector<std::size_t>{3, 4});
+    REQUIRE_FALSE(pattern.contains(4, 0));
+  }
+
+  SECTION("Hessian of a separable sum is diagonal") {
+    const SparsityPattern pattern = hessian_sparsity(Separable{}, point);
+    REQUIRE(pattern.num_nonzeros() == 5);
+    for (std::size_t i = 0; i < 5; i++)
+      REQUIRE(pattern.row(i) == std::vector<std::size_t>{i});
+    REQUIRE(colour_columns(pattern).num_colours == 1);
+  }
+
+  SECTION("Linear terms and constants create no interaction") {
+    auto f = [](auto x, auto y, auto z) { return 3.0 * x + y * 2.0 - z + x * y; };
+    const SparsityPattern pattern = hessian_sparsity(f, Vector(1.0, 2.0, 3.0));
+    REQUIRE(pattern.num_nonzeros() == 2);
+    REQUIRE(pattern.contains(0, 1));
+    REQUIRE(pattern.contains(1, 0));
+    REQUIRE(pattern.row(2).empty());
+  }
+}
+
+TEST_CASE("Column colouring", "[sparsity]") {
+  SECTION("Tridiagonal pattern needs three colours") {
+    SparsityPattern pattern(8, 8);
+    for (std::size_t i = 0; i < 8; i++)
+      for (std::size_t j = i > 0 ? i - 1 : 0; j <= std::min<std::size_t>(i + 1, 7); j++)
+        pattern.add(i, j);
+    const SeedColouring colouring = colour_columns(pattern);
+    REQUIRE(colouring.num_colours == 3);
+    for (std::size_t j = 0; j < 8; j++)
+      REQUIRE(colouring.colours[j] == j % 3);
+  }
+
+  SECTION("Dense pattern needs one colour per column") {
+    SparsityPattern pattern(1, 4);
+    for (std::size_t j = 0; j < 4; j++)
+      pattern.add(0, j);
+    REQUIRE(colour_columns(pattern).num_colours == 4);
+  }
+}
+
+TEST_CASE("Compressed Jacobian", "[sparsity][jacobian]") {
+  int calls = 0;
+  auto residuals = [&calls](auto a, auto b, auto c, auto d, auto e, auto g) {
+    calls++;
+    return Vector{a * a - b, b * c, sin(c) + d, d * e, exp(e) - g, g * a};
+  };
+  Vector point(0.3, -0.7, 1.1, 0.5, -0.2, 0.9);
+
+  const SparseSeeds seeds = sparse_jacobian_seeds(residuals, point);
+  REQUIRE(seeds.colouring.num_colours < 6);
+
+  calls = 0;
+  const auto sparse = value_and_jacobian(residuals, point, seeds);
+  REQUIRE(calls == int(seeds.colouring.num_colours));
+
+  const auto dense = value_and_jacobian(residuals, point);
+  for (std::size_t i = 0; i < 6; i++) {
+    REQUIRE(sparse.residuals[i] == Approx(dense.residuals[i]));
+    for (std::size_t j = 0; j < 6; j++)
+      REQUIRE(sparse.jacobian(i, j) == Approx(dense.jacobian(i, j)).margin(1e-15));
+  }
+}
+
+TEST_CASE("Compressed Hessian", "[sparsity][hessian]") {
+  SECTION("Separable sum, a single pass") {
+    Vector point(0.5, 1.0, -0.5, 2.0, 0.25, -1.5);
+    int calls = 0;
+    auto f = [&calls](auto... x) {
+      calls++;
+      return Separable{}(x...);
+    };
+    const SparseSeeds seeds = sparse_hessian_seeds(f, point);
+
+    calls = 0;
+    const auto sparse = value_gradient_hessian(f, point, seeds);
+    REQUIRE(calls == 1);
+
+    const auto dense = value_gradient_hessian(f, point);
+    REQUIRE(sparse.value == Approx(dense.value));
+    for (std::size_t i = 0; i < 6; i++) {
+      REQUIRE(sparse.gradient[i] == Approx(dense.gradient[i]));
+      for (std::size_t j = 0; j < 6; j++)
+        REQUIRE(sparse.hessian(i, j) == Approx(dense.hessian(i, j)).margin(1e-15));
+    }
+  }
+
+  SECTION("Elementary functions at compile time") {
+    // seeded with s = e_0, so the products are the first Hessian column
+    auto f = [] {
+      const HessianLanes<double, 2> x(0.5, 0, 1.0), y(1.2, 1, 0.0);
+      return exp(x) * sin(y) + pow(x, 3.0) * log(y) + sqrt(x) * cos(y) + tan(x);
+    };
+    constexpr HessianLanes<double, 2> h = f();
+    static_assert(h.real() > 0.0);
+    const HessianLanes<double, 2> runtime = f();
+    REQUIRE(h.real() == Approx(runtime.real()).epsilon(1e-14));
+    REQUIRE(h.direction() == Approx(runtime.direction()).epsilon(1e-14));
+    for (std::size_t k = 0; k < 2; k++) {
+      REQUIRE(h.dual(k) == Approx(runtime.dual(k)).epsilon(1e-14));
+      REQUIRE(h.product(k) == Approx(runtime.product(k)).epsilon(1e-14));
+    }
+  }
+
+  SECTION("Coupled neighbours, three passes") {
+    constexpr std::size_t n = 12;
+    Vector<double, n> point{};
+    for (std::size_t i = 0; i < n; i++)
+      point[i] = 0.1 * double(i) - 0.4;
+    auto f = []<typename... X>(X... x) {
+      using S = std::common_type_t<X...>;
+      const std::array<S, sizeof...(X)> values{x...};
+      S sum = values[0] * values[0];
+      for (std::size_t i = 0; i + 1 < values.size(); i++) {
+        const S d = values[i + 1] - values[i];
+        sum = sum + d * d * (values[i + 1] + 2.0) + sqrt(values[i] * values[i] + 1.0);
+      }
+      return sum / 2.0;
+    };
+
+    const SparseSeeds seeds = sparse_hessian_seeds(f, point);
+    REQUIRE(seeds.colouring.num_colours == 3);
+    REQUIRE(seeds.pattern.num_nonzeros() == 3 * n - 2);
+
+    const auto sparse = value_gradient_hessian(f, point, seeds);
+    const auto dense = value_gradient_hessian(f, point);
+    REQUIRE(sparse.value == Approx(dense.value));
+    for (std::size_t i = 0; i < n; i++) {
+      REQUIRE(sparse.gradient[i] == Approx(dense.gradient[i]));
+      for (std::size_t j = 0; j < n; j++)
+        REQUIRE(sparse.hessian(i, j) == Approx(dense.hessian(i, j)).margin(1e-12));
+    }
+    REQUIRE(hessian(f, point, seeds)(3, 4) == Approx(dense.hessian(3, 4)));
+  }
+
+  SECTION("Elementary functions and quotients") {
+    auto f = [](auto x, auto y) {
+      return log(x) * tan(y) + pow(x, 3) / cos(y) + 1.0 / (x + y) + exp(x * y);
+    };
+    Vector point(1.3, 0.4);
+    const SparseSeeds seeds = sparse_hessian_seeds(f, point);
+    const auto sparse = value_gradient_hessian(f, point, seeds);
+    const auto dense = value_gradient_hessian(f, point);
+    for (std::size_t i = 0; i < 2; i++)
+      for (std::size_t j = 0; j < 2; j++)
+        REQUIRE(sparse.hessian(i, j) == Approx(dense.hessian(i, j)));
+  }
+}
@@ -0,0 +1,138 @@
+#include <gradual/stochastic.h>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <span>
+#include <vector>
+
+using Catch::Approx;
+
+struct Sample {
+  double x, y;
+};
+
+// y = 2 x - 1 with a small deterministic perturbation
+std::vector<Sample> make_line(std::size_t count) {
+  std::vector<Sample> samples(count);
+  for (std::size_t i = 0; i < count; i++) {
+    const double x = -1.0 + 2.0 * double(i) / double(count);
+    samples[i] = {x, 2.0 * x - 1.0 + 0.05 * std::sin(17.0 * double(i))};
+  }
+  return samples;
+}
+
+auto squared_error = [](const Sample &s, auto a, auto b) {
+  auto r = a * s.x + b - s.y;
+  return r * r;
+};
+
+TEST_CASE("Stochastic: update rules fit a line in a few epochs", "[stochastic]") {
+  const auto samples = make_line(20000);
+  const Vector start{0.0, 0.0};
+
+  SECTION("Adam") {
+    StochasticOptimiser<double> opt(32, 3, Adam<double>{.learning_rate = 0.01});
+    auto res = opt.minimise_over(samples, squared_error, start);
+    REQUIRE(res.num_epochs() == 3);
+    REQUIRE(res.num_samples() == 3 * 20000);
+    REQUIRE(res.num_batches() == 3 * 625);
+    REQUIRE(res.point()[0] == Approx(2.0).margin(2e-2));
+    REQUIRE(res.point()[1] == Approx(-1.0).margin(2e-2));
+    REQUIRE(res.loss() < 1e-2);
+    REQUIRE(res.samples_per_second() > 0.0);
+  }
+
+  SECTION("Momentum") {
+    StochasticOptimiser<double, Momentum<double>> opt(32, 3, {.learning_rate = 0.01});
+    auto res = opt.minimise_over(samples, squared_error, start);
+    REQUIRE(res.point()[0] == Approx(2.0).margin(2e-2));
+    REQUIRE(res.point()[1] == Approx(-1.0).margin(2e-2));
+  }
+
+  SECTION("Plain SGD") {
+    StochasticOptimiser<double, Sgd<double>> opt(32, 3, {.learning_rate = 0.05});
+    auto res = opt.minimise_over(samples, squared_error, start);
+    REQUIRE(res.point()[0] == Approx(2.0).margin(2e-2));
+    REQUIRE(res.point()[1] == Approx(-1.0).margin(2e-2));
+  }
+}
+
+// one step of rule from x = (1, -2) with gradient (0.5, -0.25)
+template <typename Rule>
+constexpr Vector<double, 2> step_once(Rule rule) {
+  Vector<double, 2> params{1.0, -2.0};
+  UpdateState<double, 2> state{};
+  rule(params, Vector<double, 2>{0.5, -0.25}, state);
+  return params;
+}
+
+TEST_CASE("Stochastic: update rules are constexpr", "[stochastic]") {
+  static_assert(step_once(Sgd<double>{.learning_rate = 0.1})[0] == 0.95);
+  static_assert(step_once(Momentum<double>{.learning_rate = 0.1})[1] == -1.975);
+  // the first Adam step is ±η whatever the gradient
+  constexpr auto adam = step_once(Adam<double>{.learning_rate = 0.1});
+  REQUIRE(adam[0] == Approx(0.9));
+  REQUIRE(adam[1] == Approx(-1.9));
+  const auto runtime = step_once(Adam<double>{.learning_rate = 0.1});
+  REQUIRE(adam[0] == Approx(runtime[0]).epsilon(1e-14));
+  REQUIRE(adam[1] == Approx(runtime[1]).epsilon(1e-14));
+}
+
+TEST_CASE("Stochastic: runs are reproducible from the seed", "[stochastic]") {
+  const auto samples = make_line(1000);
+  StochasticOptimiser<double> a(10, 2, {}, 7), b(10, 2, {}, 7), c(10, 2, {}, 8);
+  const Vector start{0.5, 0.5};
+
+  auto ra = a.minimise_over(samples, squared_error, start);
+  auto rb = b.minimise_over(samples, squared_error, start);
+  auto rc = c.minimise_over(samples, squared_error, start);
+  REQUIRE(ra.point()[0] == rb.point()[0]);
+  REQUIRE(ra.point()[1] == rb.point()[1]);
+  REQUIRE(ra.point()[0] != rc.point()[0]);
+}
+
+TEST_CASE("Stochastic: per-batch loss and epoch observer", "[stochastic]") {
+  const auto samples = make_line(5000);
+  std::size_t largest_batch{0}, visited{0};
+  auto batch_loss = [&](std::span<const std::size_t> batch, auto a, auto b) {
+    largest_batch = std::max(largest_batch, batch.size());
+    visited += batch.size();
+    auto sum = a * 0.0;
+    for (std::size_t index : batch)
+      sum = sum + squared_error(samples[index], a, b);
+    return sum * (1.0 / double(batch.size()));
+  };
+
+  std::vector<EpochInfo<double>> epochs;
+  auto observer = [&](const EpochInfo<double> &info) {
+    epochs.push_back(info);
+    return info.epoch < 2;
+  };
+
+  // ForwardGradient evaluates the loss once per parameter
+  StochasticOptimiser<double> opt(64, 10, Adam<double>{.learning_rate = 0.02});
+  auto res =
+      opt.minimise_batches(samples.size(), batch_loss, Vector{0.0, 0.0}, observer);
+  REQUIRE(res.num_epochs() == 2);
+  REQUIRE(epochs.size() == 2);
+  REQUIRE(epochs[1].num_samples == 2 * 5000);
+  REQUIRE(epochs[1].loss < epochs[0].loss);
+  REQUIRE(epochs[1].samples_per_second > 0.0);
+  REQUIRE(largest_batch == 64);
+  REQUIRE(visited == 2 * 2 * 5000);
+}
+
+TEST_CASE("Stochastic: runtime-size parameters", "[stochastic]") {
+  // every sample pulls one coordinate towards its target
+  const std::size_t n = 50;
+  auto loss = [n](std::size_t index, auto x) {
+    auto r = x[index % n] - double(index % n);
+    return r * r;
+  };
+
+  StochasticOptimiser<double> opt(25, 400, Adam<double>{.learning_rate = 0.05});
+  auto res = opt.minimise_over(10 * n, loss, DynamicVector<double>(n, 0.0));
+  REQUIRE(res.point().size() == n);
+  for (std::size_t i = 0; i < n; i++)
+    REQUIRE(res.point()[i] == Approx(double(i)).margin(1e-2));
+}
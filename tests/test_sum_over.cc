@@ -0,0 +1,126 @@
+#include <gradual/gradient.h>
+#include <gradual/optimiser.h>
+#include <gradual/reverse.h>
+#include <gradual/sum_over.h>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+using Catch::Approx;
+
+struct Sample {
+  double x, y;
+};
+
+// y = 0.5 x^2 + x + 2 with a small deterministic perturbation
+std::vector<Sample> make_samples(std::size_t count) {
+  std::vector<Sample> samples(count);
+  for (std::size_t i = 0; i < count; i++) {
+    const double x = -2.0 + 4.0 * double(i) / double(count);
+    samples[i] = {x, 0.5 * x * x + x + 2.0 + 0.01 * std::sin(37.0 * double(i))};
+  }
+  return samples;
+}
+
+auto squared_residual = [](const Sample &s, auto a, auto b, auto c) {
+  auto r = a * s.x * s.x + b * s.x + c - s.y;
+  return r * r;
+};
+
+TEST_CASE("sum_over: value and gradient of a sum of terms", "[sum_over]") {
+  const auto samples = make_samples(1000);
+  ThreadPool pool(4);
+  auto objective =
+      sum_over(samples, squared_residual, {.chunk_size = 64, .pool = &pool});
+  REQUIRE(objective.size() == 1000);
+
+  // same sum written as a plain loop
+  auto reference = [&](auto a, auto b, auto c) {
+    auto sum = a * 0.0;
+    for (const Sample &s : samples)
+      sum = sum + squared_residual(s, a, b, c);
+    return sum;
+  };
+
+  Vector point(0.3, 0.7, 1.5);
+  auto expected = value_and_gradient(reference, point);
+  auto result = value_and_gradient(objective, point);
+  REQUIRE(result.value == Approx(expected.value).epsilon(1e-12));
+  for (std::size_t i = 0; i < 3; i++)
+    REQUIRE(result.gradient[i] == Approx(expected.gradient[i]).epsilon(1e-12));
+
+  SECTION("Tangent lanes and reverse mode") {
+    auto lanes = gradient<3>(objective, point);
+    auto reverse = reverse_gradient(objective, point);
+    for (std::size_t i = 0; i < 3; i++) {
+      REQUIRE(lanes[i] == Approx(expected.gradient[i]).epsilon(1e-12));
+      REQUIRE(reverse[i] == Approx(expected.gradient[i]).epsilon(1e-12));
+    }
+  }
+}
+
+// the objective holds the dataset by reference, so it must not be a temporary
+template <typename Data>
+concept summable = requires(Data &&data) {
+  sum_over(std::forward<Data>(data), squared_residual);
+};
+
+TEST_CASE("sum_over: temporary datasets are rejected", "[sum_over]") {
+  STATIC_REQUIRE(summable<const std::vector<Sample> &>);
+  STATIC_REQUIRE(summable<std::vector<Sample> &>);
+  STATIC_REQUIRE_FALSE(summable<std::vector<Sample>>);
+  STATIC_REQUIRE_FALSE(summable<const std::vector<Sample>>);
+}
+
+TEST_CASE("sum_over: results do not depend on the thread count", "[sum_over]") {
+  const auto samples = make_samples(10007);
+  ThreadPool serial(1), parallel(4);
+  auto a = sum_over(samples, squared_residual, {.chunk_size = 100, .pool = &serial});
+  auto b = sum_over(samples, squared_residual, {.chunk_size = 100, .pool = &parallel});
+
+  Vector point(0.1, -0.4, 2.5);
+  auto ga = value_and_gradient(a, point);
+  auto gb = value_and_gradient(b, point);
+  REQUIRE(ga.value == gb.value);
+  for (std::size_t i = 0; i < 3; i++)
+    REQUIRE(ga.gradient[i] == gb.gradient[i]);
+}
+
+TEST_CASE("sum_over: by index and on runtime-size points", "[sum_over]") {
+  SECTION("Empty and short datasets") {
+    auto empty = sum_over(0, [](std::size_t, double x) { return x; });
+    REQUIRE(empty(3.0) == 0.0);
+    auto three = sum_over(3, [](std::size_t i, double x) { return double(i) * x; });
+    REQUIRE(three(2.0) == 6.0);
+  }
+
+  SECTION("Span parameters") {
+    // Σ_i (x_{i mod n} - i)^2 over 300 samples
+    auto objective = sum_over(
+        300,
+        [](std::size_t i, auto x) {
+          auto r = x[i % x.size()] - double(i);
+          return r * r;
+        },
+        {.chunk_size = 32});
+    DynamicVector<double> point(3, 0.0);
+    auto grad = gradient(objective, point);
+    // ∂/∂x_j = -2 Σ_{i ≡ j} i, with i = j, j + 3, ..., j + 297
+    for (std::size_t j = 0; j < 3; j++)
+      REQUIRE(grad[j] == Approx(-2.0 * (100.0 * double(j) + 3.0 * 4950.0)));
+  }
+}
+
+TEST_CASE("sum_over: least-squares fit with Optimiser", "[sum_over]") {
+  const auto samples = make_samples(20000);
+  auto objective = sum_over(samples, squared_residual, {.chunk_size = 1024});
+
+  Optimiser<double, ForwardGradient, StrongWolfe<double>> opt(1.0, 1e-4);
+  auto res = opt.minimise(objective, Vector(0.1, 0.5, 1.0));
+  REQUIRE(res.converged());
+  REQUIRE(res.point()[0] == Approx(0.5).margin(1e-2));
+  REQUIRE(res.point()[1] == Approx(1.0).margin(1e-2));
+  REQUIRE(res.point()[2] == Approx(2.0).margin(1e-2));
+}
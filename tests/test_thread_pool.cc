@@ -0,0 +1,69 @@
+#include <gradual/thread_pool.h>
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+TEST_CASE("ThreadPool: every index runs exactly once", "[thread_pool]") {
+  ThreadPool pool(4);
+  REQUIRE(pool.size() == 4);
+
+  SECTION("Even work") {
+    std::vector<std::atomic<int>> visits(1000);
+    pool.parallel_for(visits.size(), [&](std::size_t i) { visits[i]++; });
+    for (const auto &count : visits)
+      REQUIRE(count == 1);
+  }
+
+  SECTION("Uneven work is stolen") {
+    // the first range is far more expensive than the others
+    std::vector<double> sums(64, 0.0);
+    pool.parallel_for(sums.size(), [&](std::size_t i) {
+      const std::size_t work = i < 16 ? 200000 : 10;
+      double sum{0};
+      for (std::size_t k = 0; k < work; k++)
+        sum += 1.0 / double(k + 1);
+      sums[i] = sum;
+    });
+    for (std::size_t i = 0; i < sums.size(); i++)
+      REQUIRE(sums[i] > 0.0);
+  }
+
+  SECTION("Repeated calls reuse the workers") {
+    std::atomic<std::size_t> total{0};
+    for (std::size_t call = 0; call < 100; call++)
+      pool.parallel_for(call, [&](std::size_t) { total++; });
+    REQUIRE(total == 99 * 100 / 2);
+  }
+
+  SECTION("Nested calls run serially") {
+    std::vector<std::atomic<int>> visits(8 * 8);
+    pool.parallel_for(8, [&](std::size_t i) {
+      pool.parallel_for(8, [&](std::size_t j) { visits[i * 8 + j]++; });
+    });
+    for (const auto &count : visits)
+      REQUIRE(count == 1);
+  }
+}
+
+TEST_CASE("ThreadPool: exceptions reach the caller", "[thread_pool]") {
+  ThreadPool pool(3);
+  REQUIRE_THROWS_AS(pool.parallel_for(100,
+                                      [](std::size_t i) {
+                                        if (i == 42)
+                                          throw std::runtime_error("index 42");
+                                      }),
+                    std::runtime_error);
+
+  // still usable afterwards
+  std::atomic<int> count{0};
+  pool.parallel_for(10, [&](std::size_t) { count++; });
+  REQUIRE(count == 10);
+}
+
+TEST_CASE("ThreadPool: single thread runs inline", "[thread_pool]") {
+  ThreadPool pool(1);
+  std::vector<std::size_t> order;
+  pool.parallel_for(5, [&](std::size_t i) { order.push_back(i); });
+  REQUIRE(order == std::vector<std::size_t>{0, 1, 2, 3, 4});
+}
@@ -1,6 +1,11 @@
+#include <gradual/dual.h>
 #include <gradual/vector.h>
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <array>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
 
 using Catch::Approx;
 
@@ -169,3 +174,143 @@ TEST_CASE("Vector magnitude", "[vector]") {
   REQUIRE(c.norm2() == Approx(30.0));
   REQUIRE(c.norm() == Approx(std::sqrt(30.0)));
 }
+
+TEST_CASE("Runtime-size vector", "[vector][dynamic]") {
+  DynamicVector<double> a(4);
+  REQUIRE(a.size() == 4);
+  REQUIRE(a[3] == 0.0);
+
+  DynamicVector<double> b(4, 2.0);
+  REQUIRE(b[0] == 2.0);
+  REQUIRE(b[3] == 2.0);
+
+  SECTION("Construction from a span") {
+    const std::array<double, 3> values{1.0, 2.0, 3.0};
+    DynamicVector<double> c{std::span<const double>(values)};
+    REQUIRE(c.size() == 3);
+    REQUIRE(c[2] == 3.0);
+    REQUIRE(c.values().data() != values.data());
+  }
+
+  SECTION("Arithmetic matches the fixed-size vector") {
+    for (std::size_t i = 0; i < 4; i++)
+      a[i] = double(i + 1);
+
+    auto sum = a + b;
+    auto diff = a - b;
+    REQUIRE(sum[3] == 6.0);
+    REQUIRE(diff[0] == -1.0);
+    REQUIRE(a * b == Approx(20.0));
+    REQUIRE((a * 2.0)[2] == 6.0);
+    REQUIRE((2.0 * a)[2] == 6.0);
+    REQUIRE((a / 2.0)[1] == 1.0);
+    REQUIRE(a.norm2() == Approx(30.0));
+    REQUIRE(b.norm() == Approx(4.0));
+  }
+
+  SECTION("Elements are contiguous") {
+    auto view = b.values();
+    REQUIRE(view.size() == 4);
+    view[1] = 7.0;
+    REQUIRE(b[1] == 7.0);
+  }
+}
+
+TEST_CASE("Vector checked element access", "[vector]") {
+  Vector v(1.0, 2.0);
+  DynamicVector<double> d(3);
+
+  REQUIRE(v.at(1) == 2.0);
+  v.at(0) = 5.0;
+  REQUIRE(v[0] == 5.0);
+  REQUIRE_THROWS_AS(v.at(2), std::out_of_range);
+  REQUIRE_THROWS_AS(d.at(3), std::out_of_range);
+
+#ifdef GRADUAL_BOUNDS_CHECK
+  // debug builds check operator[] as well
+  REQUIRE_THROWS_AS(v[2], std::out_of_range);
+  REQUIRE_THROWS_AS(d[3], std::out_of_range);
+#endif
+}
+
+TEST_CASE("Vector expression templates", "[vector][expression]") {
+  Vector x(1.0, 2.0, 3.0);
+  Vector g(0.5, -1.0, 2.0);
+  Vector v(1.0, 1.0, 1.0);
+
+  SECTION("Arithmetic is lazy until assigned") {
+    auto expr = x - 0.1 * g + 0.9 * v;
+    STATIC_REQUIRE_FALSE(std::is_same_v<decltype(expr), Vector<double, 3>>);
+    STATIC_REQUIRE(decltype(expr)::extent == 3);
+    REQUIRE(expr.size() == 3);
+
+    Vector<double, 3> result = expr;
+    REQUIRE(result[0] == Approx(1.0 - 0.05 + 0.9));
+    REQUIRE(result[1] == Approx(2.0 + 0.1 + 0.9));
+    REQUIRE(result[2] == Approx(3.0 - 0.2 + 0.9));
+    REQUIRE(expr.norm2() == Approx(result.norm2()));
+    REQUIRE((x - g) * v == Approx(4.5));
+  }
+
+  SECTION("Assignment may alias its operands") {
+    x = x - g * 2.0;
+    REQUIRE(x[0] == 0.0);
+    REQUIRE(x[1] == 4.0);
+    REQUIRE(x[2] == -1.0);
+  }
+
+  SECTION("Compound assignment") {
+    x += g;
+    x -= v * 2.0;
+    x *= 2.0;
+    x /= 4.0;
+    REQUIRE(x[0] == Approx(-0.25));
+    REQUIRE(x[1] == Approx(-0.5));
+    REQUIRE(x[2] == Approx(1.5));
+  }
+
+  SECTION("Temporary operands are held by value") {
+    auto expr = Vector(1.0, 1.0, 1.0) + x;
+    Vector<double, 3> result = expr;
+    REQUIRE(result[2] == 4.0);
+  }
+
+  SECTION("Deduction from an expression") {
+    Vector sum(x + g);
+    STATIC_REQUIRE(std::is_same_v<decltype(sum), Vector<double, 3>>);
+    REQUIRE(sum[1] == 1.0);
+  }
+
+  SECTION("Evaluated at compile time") {
+    constexpr Vector<double, 2> a(1.0, 2.0), b(3.0, 4.0);
+    constexpr Vector<double, 2> c = a * 2.0 + b / 2.0;
+    STATIC_REQUIRE(c[0] == 3.5);
+    STATIC_REQUIRE(c[1] == 6.0);
+  }
+}
+
+TEST_CASE("Vector expressions over Dual and runtime-size vectors",
+          "[vector][expression][dynamic]") {
+  SECTION("Dual elements") {
+    Vector<Dual<double>, 2> x(Dual(1.0, 1.0), Dual(2.0, 0.0));
+    Vector<Dual<double>, 2> g(Dual(0.5, 0.0), Dual(1.0, 1.0));
+    Vector<Dual<double>, 2> result = x - g * Dual(2.0, 0.0);
+    REQUIRE(result[0].real() == 0.0);
+    REQUIRE(result[0].dual() == 1.0);
+    REQUIRE(result[1].real() == 0.0);
+    REQUIRE(result[1].dual() == -2.0);
+  }
+
+  SECTION("Runtime size") {
+    DynamicVector<double> x(1000, 1.0), g(1000, 2.0);
+    const double *storage = x.values().data();
+    x = x - 0.25 * g + x;
+    REQUIRE(x.size() == 1000);
+    REQUIRE(x.values().data() == storage); // updated in place
+    REQUIRE(x[999] == 1.5);
+    REQUIRE((x - g).norm2() == Approx(1000 * 0.25));
+
+    DynamicVector<double> y = x * 2.0;
+    REQUIRE(y[0] == 3.0);
+  }
+}